@@ -0,0 +1,405 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+// Compares the cost of calling through an any with
+// a hand-written virtual function and std::function.
+
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/builtin.hpp>
+#include <boost/type_erasure/callable.hpp>
+#include <boost/type_erasure/member.hpp>
+#include <boost/type_erasure/call.hpp>
+#include <boost/type_erasure/operators.hpp>
+#include <boost/type_erasure/relaxed.hpp>
+#include <boost/type_erasure/small_buffer.hpp>
+#include <boost/type_erasure/closed.hpp>
+#include <boost/type_erasure/call_each.hpp>
+#include <boost/type_erasure/any_collection.hpp>
+#include <boost/type_erasure/any_vector.hpp>
+#include <boost/type_erasure/batched.hpp>
+#include <boost/type_erasure/typeid_of.hpp>
+#include <boost/mpl/vector.hpp>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "benchmark.hpp"
+
+namespace te = boost::type_erasure;
+
+BOOST_TYPE_ERASURE_MEMBER(get)
+
+template<std::size_t N>
+struct functor : benchmark::payload<N>
+{
+    explicit functor(int v = 0) : benchmark::payload<N>(v) {}
+    int operator()() const { return this->get(); }
+};
+
+struct base
+{
+    virtual ~base() {}
+    virtual int get() const = 0;
+};
+
+template<std::size_t N>
+struct derived : base
+{
+    explicit derived(int v) : p(v) {}
+    int get() const { return p.get(); }
+    benchmark::payload<N> p;
+};
+
+typedef boost::mpl::vector<
+    te::copy_constructible<>,
+    has_get<int() const, const te::_self>
+> member_concept;
+
+typedef boost::mpl::vector<
+    te::copy_constructible<>,
+    te::callable<int(), const te::_self>
+> callable_concept;
+
+template<std::size_t N>
+void virtual_call(benchmark::state& state)
+{
+    std::unique_ptr<base> x(new derived<N>(1));
+    const base* p = x.get();
+    benchmark::do_not_optimize(p);
+    int sum = 0;
+    while(state.keep_running()) {
+        sum += p->get();
+        benchmark::do_not_optimize(sum);
+    }
+}
+
+template<std::size_t N>
+void std_function_call(benchmark::state& state)
+{
+    std::function<int()> f = functor<N>(1);
+    int sum = 0;
+    while(state.keep_running()) {
+        sum += f();
+        benchmark::do_not_optimize(sum);
+    }
+}
+
+template<std::size_t N>
+void any_member_call(benchmark::state& state)
+{
+    const te::any<member_concept> x(derived<N>(1));
+    int sum = 0;
+    while(state.keep_running()) {
+        sum += x.get();
+        benchmark::do_not_optimize(sum);
+    }
+}
+
+template<std::size_t N>
+void any_callable_call(benchmark::state& state)
+{
+    const te::any<callable_concept> f = functor<N>(1);
+    int sum = 0;
+    while(state.keep_running()) {
+        sum += f();
+        benchmark::do_not_optimize(sum);
+    }
+}
+
+template<std::size_t N>
+void any_small_buffer_call(benchmark::state& state)
+{
+    typedef boost::mpl::vector<callable_concept, te::small_buffer<> > concept_type;
+    const te::any<concept_type> f = functor<N>(1);
+    int sum = 0;
+    while(state.keep_running()) {
+        sum += f();
+        benchmark::do_not_optimize(sum);
+    }
+}
+
+template<std::size_t N>
+void any_closed_call(benchmark::state& state)
+{
+    typedef boost::mpl::vector<
+        callable_concept,
+        te::closed<boost::mpl::vector<functor<8>, functor<256> > >
+    > concept_type;
+    const te::any<concept_type> f = functor<N>(1);
+    int sum = 0;
+    while(state.keep_running()) {
+        sum += f();
+        benchmark::do_not_optimize(sum);
+    }
+}
+
+template<std::size_t N>
+void te_call(benchmark::state& state)
+{
+    const te::any<callable_concept> f = functor<N>(1);
+    int sum = 0;
+    while(state.keep_running()) {
+        sum += te::call(te::callable<int(), const te::_self>(), f);
+        benchmark::do_not_optimize(sum);
+    }
+}
+
+// Guesses functor<8>, so the call for functor<256> misses.
+template<std::size_t N>
+void te_guarded_call(benchmark::state& state)
+{
+    const te::any<callable_concept> f = functor<N>(1);
+    int sum = 0;
+    while(state.keep_running()) {
+        sum += te::guarded_call<functor<8> >(te::callable<int(), const te::_self>(), f);
+        benchmark::do_not_optimize(sum);
+    }
+}
+
+typedef boost::mpl::vector<
+    te::copy_constructible<>,
+    te::addable<>,
+    te::relaxed
+> number_concept;
+
+// Each sum is a new object, which is created in the
+// buffer of the result when there is one.
+template<class Concept>
+void any_add(benchmark::state& state)
+{
+    te::any<Concept> sum(0.0);
+    const te::any<Concept> one(1.0);
+    while(state.keep_running()) {
+        sum = sum + one;
+        benchmark::do_not_optimize(sum);
+    }
+}
+
+// The same, with each sum replacing the previous one.
+template<class Concept>
+void any_add_into(benchmark::state& state)
+{
+    te::any<Concept> sum(0.0);
+    const te::any<Concept> one(1.0);
+    while(state.keep_running()) {
+        te::call_into(sum, te::addable<>(), sum, one);
+        benchmark::do_not_optimize(sum);
+    }
+}
+
+template<int K>
+struct accumulator
+{
+    void operator()(int& sum) const { sum += K; }
+};
+
+typedef boost::mpl::vector<
+    te::copy_constructible<>,
+    te::callable<void(int&), const te::_self>
+> accumulator_concept;
+
+// 4096 objects of four types in a pseudo-random order.
+// Each iteration visits all of them.
+template<class Container>
+struct push_back_to
+{
+    template<class T>
+    void operator()(const T& arg) const { c->push_back(arg); }
+    Container* c;
+};
+
+template<class Container>
+struct insert_into
+{
+    template<class T>
+    void operator()(const T& arg) const { c->insert(arg); }
+    Container* c;
+};
+
+template<class Add>
+void fill_mixed(Add add)
+{
+    unsigned seed = 1;
+    for(int i = 0; i < 4096; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        switch((seed >> 16) % 4) {
+        case 0: add(accumulator<1>()); break;
+        case 1: add(accumulator<2>()); break;
+        case 2: add(accumulator<3>()); break;
+        default: add(accumulator<4>()); break;
+        }
+    }
+}
+
+std::vector<te::any<accumulator_concept> > make_mixed()
+{
+    std::vector<te::any<accumulator_concept> > result;
+    push_back_to<std::vector<te::any<accumulator_concept> > > add = { &result };
+    fill_mixed(add);
+    return result;
+}
+
+void mixed_loop(benchmark::state& state)
+{
+    const std::vector<te::any<accumulator_concept> > objects = make_mixed();
+    int sum = 0;
+    while(state.keep_running()) {
+        for(std::size_t i = 0; i < objects.size(); ++i) {
+            objects[i](sum);
+        }
+        benchmark::do_not_optimize(sum);
+    }
+}
+
+void mixed_call_each(benchmark::state& state)
+{
+    const std::vector<te::any<accumulator_concept> > objects = make_mixed();
+    int sum = 0;
+    while(state.keep_running()) {
+        te::call_each(te::callable<void(int&), const te::_self>(), objects, sum);
+        benchmark::do_not_optimize(sum);
+    }
+}
+
+struct apply_accumulator
+{
+    explicit apply_accumulator(int& s) : sum(&s) {}
+    void operator()(te::any<accumulator_concept, const te::_self&> arg) const { arg(*sum); }
+    int* sum;
+};
+
+void mixed_collection(benchmark::state& state)
+{
+    te::any_collection<accumulator_concept> collection;
+    insert_into<te::any_collection<accumulator_concept> > add = { &collection };
+    fill_mixed(add);
+    int sum = 0;
+    while(state.keep_running()) {
+        collection.for_each(apply_accumulator(sum));
+        benchmark::do_not_optimize(sum);
+    }
+}
+
+void mixed_any_vector(benchmark::state& state)
+{
+    te::any_vector<accumulator_concept> objects;
+    push_back_to<te::any_vector<accumulator_concept> > add = { &objects };
+    fill_mixed(add);
+    int sum = 0;
+    while(state.keep_running()) {
+        objects.for_each(apply_accumulator(sum));
+        benchmark::do_not_optimize(sum);
+    }
+}
+
+typedef boost::mpl::vector<
+    accumulator_concept,
+    te::typeid_<>
+> filter_concept;
+
+// Counts the objects of one type among 2^20, which only
+// needs the bindings.
+void filter_vector(benchmark::state& state)
+{
+    std::vector<te::any<filter_concept> > objects;
+    for(int i = 0; i < (1 << 20); ++i) {
+        if(i % 3 == 0) objects.push_back(accumulator<1>());
+        else objects.push_back(accumulator<2>());
+    }
+    while(state.keep_running()) {
+        int n = 0;
+        for(std::size_t i = 0; i < objects.size(); ++i) {
+            n += (te::typeid_of(objects[i]) == typeid(accumulator<1>));
+        }
+        benchmark::do_not_optimize(n);
+    }
+}
+
+void filter_any_vector(benchmark::state& state)
+{
+    te::any_vector<filter_concept> objects;
+    for(int i = 0; i < (1 << 20); ++i) {
+        if(i % 3 == 0) objects.push_back(accumulator<1>());
+        else objects.push_back(accumulator<2>());
+    }
+    while(state.keep_running()) {
+        int n = 0;
+        for(std::size_t i = 0; i < objects.size(); ++i) {
+            n += (te::typeid_of(objects[i]) == typeid(accumulator<1>));
+        }
+        benchmark::do_not_optimize(n);
+    }
+}
+
+struct sink
+{
+    sink() : sum(0) {}
+    void operator()(const int& record) { sum += record * 3 + 1; }
+    int sum;
+};
+
+typedef boost::mpl::vector<
+    te::copy_constructible<>,
+    te::callable<void(const int&)>,
+    te::batched<te::callable<void(const int&)> >
+> sink_concept;
+
+// Passes 4096 records to a sink, one call at a time or
+// in one batch.
+void sink_loop(benchmark::state& state)
+{
+    te::any<sink_concept> target((sink()));
+    std::vector<int> records(4096, 1);
+    while(state.keep_running()) {
+        for(std::size_t i = 0; i < records.size(); ++i) {
+            target(records[i]);
+        }
+    }
+    benchmark::do_not_optimize(target);
+}
+
+void sink_batch(benchmark::state& state)
+{
+    te::any<sink_concept> target((sink()));
+    std::vector<int> records(4096, 1);
+    while(state.keep_running()) {
+        target.call_batch(&records[0], records.size());
+    }
+    benchmark::do_not_optimize(target);
+}
+
+BENCHMARK(virtual_call<8>);
+BENCHMARK(virtual_call<256>);
+BENCHMARK(std_function_call<8>);
+BENCHMARK(std_function_call<256>);
+BENCHMARK(any_member_call<8>);
+BENCHMARK(any_member_call<256>);
+BENCHMARK(any_callable_call<8>);
+BENCHMARK(any_callable_call<256>);
+BENCHMARK(any_small_buffer_call<8>);
+BENCHMARK(any_small_buffer_call<256>);
+BENCHMARK(any_closed_call<8>);
+BENCHMARK(any_closed_call<256>);
+BENCHMARK(te_call<8>);
+BENCHMARK(te_call<256>);
+BENCHMARK(te_guarded_call<8>);
+BENCHMARK(te_guarded_call<256>);
+BENCHMARK(any_add<number_concept>);
+BENCHMARK(any_add<boost::mpl::vector<number_concept, te::small_buffer<> > >);
+BENCHMARK(any_add_into<number_concept>);
+BENCHMARK(mixed_loop);
+BENCHMARK(mixed_call_each);
+BENCHMARK(mixed_collection);
+BENCHMARK(mixed_any_vector);
+BENCHMARK(filter_vector);
+BENCHMARK(filter_any_vector);
+BENCHMARK(sink_loop);
+BENCHMARK(sink_batch);
+
+BENCHMARK_MAIN()
@@ -0,0 +1,184 @@
+// Boost.TypeErasure library
+//
+// Copyright 2015 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+// Compares any_cast and dynamic_any_cast with std::any_cast
+// and dynamic_cast, and measures conversion between bindings.
+
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/builtin.hpp>
+#include <boost/type_erasure/operators.hpp>
+#include <boost/type_erasure/any_cast.hpp>
+#include <boost/type_erasure/binding.hpp>
+#include <boost/type_erasure/dynamic_binding.hpp>
+#include <boost/type_erasure/dynamic_any_cast.hpp>
+#include <boost/type_erasure/register_binding.hpp>
+#include <boost/mpl/vector.hpp>
+#include <boost/mpl/map.hpp>
+#include <memory>
+#include "benchmark.hpp"
+#ifdef BENCHMARK_HAS_STD_ANY
+#include <any>
+#endif
+
+namespace te = boost::type_erasure;
+
+typedef benchmark::payload<8> small_payload;
+typedef benchmark::payload<256> large_payload;
+
+struct base
+{
+    virtual ~base() {}
+};
+
+template<class T>
+struct derived : base
+{
+    explicit derived(int v) : p(v) {}
+    T p;
+};
+
+template<class T = te::_self>
+struct common : boost::mpl::vector<
+    te::copy_constructible<T>,
+    te::typeid_<T>
+> {};
+
+typedef boost::mpl::vector<common<>, te::relaxed> base_concept;
+typedef boost::mpl::vector<common<>, te::incrementable<>, te::relaxed> derived_concept;
+
+template<class T>
+void dynamic_cast_(benchmark::state& state)
+{
+    std::unique_ptr<base> x(new derived<T>(1));
+    base* p = x.get();
+    benchmark::do_not_optimize(p);
+    while(state.keep_running()) {
+        derived<T>* result = dynamic_cast<derived<T>*>(p);
+        benchmark::do_not_optimize(result);
+    }
+}
+
+#ifdef BENCHMARK_HAS_STD_ANY
+
+template<class T>
+void std_any_cast(benchmark::state& state)
+{
+    std::any x = T(1);
+    while(state.keep_running()) {
+        T* result = std::any_cast<T>(&x);
+        benchmark::do_not_optimize(result);
+    }
+}
+
+#endif
+
+template<class T>
+void any_cast_(benchmark::state& state)
+{
+    te::any<base_concept> x = T(1);
+    while(state.keep_running()) {
+        T* result = te::any_cast<T*>(&x);
+        benchmark::do_not_optimize(result);
+    }
+}
+
+void any_cast_failure(benchmark::state& state)
+{
+    te::any<base_concept> x = small_payload(1);
+    while(state.keep_running()) {
+        large_payload* result = te::any_cast<large_payload*>(&x);
+        benchmark::do_not_optimize(result);
+    }
+}
+
+void dynamic_any_cast_(benchmark::state& state)
+{
+    te::any<base_concept> x(1);
+    while(state.keep_running()) {
+        te::any<derived_concept> y = te::dynamic_any_cast<te::any<derived_concept> >(x);
+        benchmark::do_not_optimize(y);
+    }
+}
+
+void dynamic_any_cast_ref(benchmark::state& state)
+{
+    te::any<base_concept> x(1);
+    while(state.keep_running()) {
+        te::any<derived_concept, te::_self&> y =
+            te::dynamic_any_cast<te::any<derived_concept, te::_self&> >(x);
+        benchmark::do_not_optimize(y);
+    }
+}
+
+void try_dynamic_any_cast_failure(benchmark::state& state)
+{
+    te::any<base_concept> x(small_payload(1));
+    while(state.keep_running()) {
+        boost::optional<te::any<derived_concept, te::_self&> > y =
+            te::try_dynamic_any_cast<te::any<derived_concept, te::_self&> >(x);
+        benchmark::do_not_optimize(y);
+    }
+}
+
+void binding_upcast(benchmark::state& state)
+{
+    te::binding<derived_concept> b = te::make_binding<boost::mpl::map<boost::mpl::pair<te::_self, int> > >();
+    while(state.keep_running()) {
+        te::binding<base_concept> result(b);
+        benchmark::do_not_optimize(result);
+    }
+}
+
+void binding_rebind(benchmark::state& state)
+{
+    typedef boost::mpl::vector<common<te::_a>, te::relaxed> rebound_concept;
+    te::binding<derived_concept> b = te::make_binding<boost::mpl::map<boost::mpl::pair<te::_self, int> > >();
+    boost::mpl::map<boost::mpl::pair<te::_a, te::_self> > map;
+    while(state.keep_running()) {
+        te::binding<rebound_concept> result(b, map);
+        benchmark::do_not_optimize(result);
+    }
+}
+
+void any_upcast(benchmark::state& state)
+{
+    te::any<derived_concept> x(1);
+    while(state.keep_running()) {
+        te::any<base_concept, te::_self&> y(x);
+        benchmark::do_not_optimize(y);
+    }
+}
+
+struct registration
+{
+    registration()
+    {
+        te::register_binding<common<>, int>();
+        te::register_binding<te::incrementable<>, int>();
+    }
+} register_int;
+
+BENCHMARK(dynamic_cast_<small_payload>);
+BENCHMARK(dynamic_cast_<large_payload>);
+#ifdef BENCHMARK_HAS_STD_ANY
+BENCHMARK(std_any_cast<small_payload>);
+BENCHMARK(std_any_cast<large_payload>);
+#endif
+BENCHMARK(any_cast_<small_payload>);
+BENCHMARK(any_cast_<large_payload>);
+BENCHMARK(any_cast_failure);
+BENCHMARK(dynamic_any_cast_);
+BENCHMARK(dynamic_any_cast_ref);
+BENCHMARK(try_dynamic_any_cast_failure);
+BENCHMARK(binding_upcast);
+BENCHMARK(binding_rebind);
+BENCHMARK(any_upcast);
+
+BENCHMARK_MAIN()
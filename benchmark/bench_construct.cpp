@@ -0,0 +1,275 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+// Compares construction, copy, and move of an any with
+// std::any, std::function, and a hand-written clone
+// through a virtual function, across payload sizes.
+
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/builtin.hpp>
+#include <boost/type_erasure/callable.hpp>
+#include <boost/type_erasure/small_buffer.hpp>
+#include <boost/type_erasure/intrusive.hpp>
+#include <boost/type_erasure/copy_on_write.hpp>
+#include <boost/mpl/vector.hpp>
+#include <functional>
+#include <memory>
+#include <utility>
+#include "benchmark.hpp"
+#ifdef BENCHMARK_HAS_STD_ANY
+#include <any>
+#endif
+
+namespace te = boost::type_erasure;
+
+template<std::size_t N>
+struct functor : benchmark::payload<N>
+{
+    explicit functor(int v = 0) : benchmark::payload<N>(v) {}
+    int operator()() const { return this->get(); }
+};
+
+struct base
+{
+    virtual ~base() {}
+    virtual base* clone() const = 0;
+};
+
+template<std::size_t N>
+struct derived : base
+{
+    explicit derived(int v) : p(v) {}
+    base* clone() const { return new derived(*this); }
+    benchmark::payload<N> p;
+};
+
+typedef te::any<boost::mpl::vector<
+    te::copy_constructible<>,
+    te::relaxed
+> > any_type;
+
+typedef te::any<boost::mpl::vector<
+    te::copy_constructible<>,
+    te::relaxed,
+    te::small_buffer<>
+> > buffered_any_type;
+
+typedef te::any<boost::mpl::vector<
+    te::copy_constructible<>,
+    te::relaxed,
+    te::intrusive
+> > intrusive_any_type;
+
+typedef te::any<boost::mpl::vector<
+    te::copy_constructible<>,
+    te::relaxed,
+    te::copy_on_write
+> > shared_any_type;
+
+template<std::size_t N>
+void virtual_construct(benchmark::state& state)
+{
+    while(state.keep_running()) {
+        std::unique_ptr<base> x(new derived<N>(1));
+        benchmark::do_not_optimize(x);
+    }
+}
+
+template<std::size_t N>
+void virtual_copy(benchmark::state& state)
+{
+    std::unique_ptr<base> x(new derived<N>(1));
+    while(state.keep_running()) {
+        std::unique_ptr<base> y(x->clone());
+        benchmark::do_not_optimize(y);
+    }
+}
+
+template<std::size_t N>
+void std_function_construct(benchmark::state& state)
+{
+    functor<N> f(1);
+    while(state.keep_running()) {
+        std::function<int()> x(f);
+        benchmark::do_not_optimize(x);
+    }
+}
+
+template<std::size_t N>
+void std_function_copy(benchmark::state& state)
+{
+    std::function<int()> x = functor<N>(1);
+    while(state.keep_running()) {
+        std::function<int()> y(x);
+        benchmark::do_not_optimize(y);
+    }
+}
+
+template<std::size_t N>
+void std_function_move(benchmark::state& state)
+{
+    std::function<int()> x = functor<N>(1);
+    while(state.keep_running()) {
+        std::function<int()> y(std::move(x));
+        x = std::move(y);
+        benchmark::do_not_optimize(x);
+    }
+}
+
+#ifdef BENCHMARK_HAS_STD_ANY
+
+template<std::size_t N>
+void std_any_construct(benchmark::state& state)
+{
+    benchmark::payload<N> p(1);
+    while(state.keep_running()) {
+        std::any x(p);
+        benchmark::do_not_optimize(x);
+    }
+}
+
+template<std::size_t N>
+void std_any_copy(benchmark::state& state)
+{
+    std::any x = benchmark::payload<N>(1);
+    while(state.keep_running()) {
+        std::any y(x);
+        benchmark::do_not_optimize(y);
+    }
+}
+
+template<std::size_t N>
+void std_any_move(benchmark::state& state)
+{
+    std::any x = benchmark::payload<N>(1);
+    while(state.keep_running()) {
+        std::any y(std::move(x));
+        x = std::move(y);
+        benchmark::do_not_optimize(x);
+    }
+}
+
+#endif
+
+template<class Any, std::size_t N>
+void any_construct(benchmark::state& state)
+{
+    benchmark::payload<N> p(1);
+    while(state.keep_running()) {
+        Any x(p);
+        benchmark::do_not_optimize(x);
+    }
+}
+
+template<class Any, std::size_t N>
+void any_copy(benchmark::state& state)
+{
+    Any x = benchmark::payload<N>(1);
+    while(state.keep_running()) {
+        Any y(x);
+        benchmark::do_not_optimize(y);
+    }
+}
+
+// The payload is trivially copyable, so copies of it
+// skip the vtable.  This one has to go through it.
+template<std::size_t N>
+struct nontrivial_payload : benchmark::payload<N>
+{
+    explicit nontrivial_payload(int v = 0) : benchmark::payload<N>(v) {}
+    nontrivial_payload(const nontrivial_payload& other) BOOST_NOEXCEPT
+      : benchmark::payload<N>(other) {}
+};
+
+template<class Any, std::size_t N>
+void any_copy_nontrivial(benchmark::state& state)
+{
+    Any x = nontrivial_payload<N>(1);
+    while(state.keep_running()) {
+        Any y(x);
+        benchmark::do_not_optimize(y);
+    }
+}
+
+template<class Any, std::size_t N>
+void any_move(benchmark::state& state)
+{
+    Any x = benchmark::payload<N>(1);
+    while(state.keep_running()) {
+        Any y(std::move(x));
+        x = std::move(y);
+        benchmark::do_not_optimize(x);
+    }
+}
+
+BENCHMARK(virtual_construct<8>);
+BENCHMARK(virtual_construct<64>);
+BENCHMARK(virtual_construct<256>);
+BENCHMARK(virtual_copy<8>);
+BENCHMARK(virtual_copy<64>);
+BENCHMARK(virtual_copy<256>);
+
+BENCHMARK(std_function_construct<8>);
+BENCHMARK(std_function_construct<64>);
+BENCHMARK(std_function_construct<256>);
+BENCHMARK(std_function_copy<8>);
+BENCHMARK(std_function_copy<64>);
+BENCHMARK(std_function_copy<256>);
+BENCHMARK(std_function_move<8>);
+BENCHMARK(std_function_move<256>);
+
+#ifdef BENCHMARK_HAS_STD_ANY
+BENCHMARK(std_any_construct<8>);
+BENCHMARK(std_any_construct<64>);
+BENCHMARK(std_any_construct<256>);
+BENCHMARK(std_any_copy<8>);
+BENCHMARK(std_any_copy<64>);
+BENCHMARK(std_any_copy<256>);
+BENCHMARK(std_any_move<8>);
+BENCHMARK(std_any_move<256>);
+#endif
+
+BENCHMARK(any_construct<any_type, 8>);
+BENCHMARK(any_construct<any_type, 64>);
+BENCHMARK(any_construct<any_type, 256>);
+BENCHMARK(any_copy<any_type, 8>);
+BENCHMARK(any_copy<any_type, 64>);
+BENCHMARK(any_copy<any_type, 256>);
+BENCHMARK(any_move<any_type, 8>);
+BENCHMARK(any_move<any_type, 256>);
+
+BENCHMARK(any_construct<buffered_any_type, 8>);
+BENCHMARK(any_construct<buffered_any_type, 64>);
+BENCHMARK(any_construct<buffered_any_type, 256>);
+BENCHMARK(any_copy<buffered_any_type, 8>);
+BENCHMARK(any_copy<buffered_any_type, 64>);
+BENCHMARK(any_copy<buffered_any_type, 256>);
+BENCHMARK(any_copy_nontrivial<buffered_any_type, 8>);
+BENCHMARK(any_copy_nontrivial<buffered_any_type, 64>);
+BENCHMARK(any_move<buffered_any_type, 8>);
+BENCHMARK(any_move<buffered_any_type, 256>);
+
+BENCHMARK(any_construct<intrusive_any_type, 8>);
+BENCHMARK(any_construct<intrusive_any_type, 64>);
+BENCHMARK(any_construct<intrusive_any_type, 256>);
+BENCHMARK(any_copy<intrusive_any_type, 8>);
+BENCHMARK(any_copy<intrusive_any_type, 64>);
+BENCHMARK(any_copy<intrusive_any_type, 256>);
+BENCHMARK(any_move<intrusive_any_type, 8>);
+BENCHMARK(any_move<intrusive_any_type, 256>);
+
+BENCHMARK(any_construct<shared_any_type, 8>);
+BENCHMARK(any_construct<shared_any_type, 256>);
+BENCHMARK(any_copy<shared_any_type, 8>);
+BENCHMARK(any_copy<shared_any_type, 256>);
+BENCHMARK(any_move<shared_any_type, 8>);
+BENCHMARK(any_move<shared_any_type, 256>);
+
+BENCHMARK_MAIN()
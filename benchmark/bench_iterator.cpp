@@ -0,0 +1,185 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+// Compares iteration through a type erased iterator with
+// a raw iterator, a hand-written virtual iterator,
+// std::function, a type erased block_range and a
+// contiguous_iterator.
+
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/builtin.hpp>
+#include <boost/type_erasure/iterator.hpp>
+#include <boost/type_erasure/block_range.hpp>
+#include <boost/type_erasure/operators.hpp>
+#include <boost/type_erasure/same_type.hpp>
+#include <boost/mpl/vector.hpp>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "benchmark.hpp"
+
+namespace te = boost::type_erasure;
+
+const std::size_t range_size = 1000;
+
+struct int_iterator_base
+{
+    virtual ~int_iterator_base() {}
+    virtual void increment() = 0;
+    virtual const int& dereference() const = 0;
+    virtual bool equal(const int_iterator_base& other) const = 0;
+};
+
+template<class Iterator>
+struct int_iterator : int_iterator_base
+{
+    explicit int_iterator(Iterator i) : it(i) {}
+    void increment() { ++it; }
+    const int& dereference() const { return *it; }
+    bool equal(const int_iterator_base& other) const
+    { return it == static_cast<const int_iterator&>(other).it; }
+    Iterator it;
+};
+
+typedef te::any<
+    boost::mpl::vector<
+        te::forward_iterator<>,
+        te::same_type<te::forward_iterator<>::value_type, int>
+    >
+> any_iterator;
+
+std::vector<int>& make_range()
+{
+    static std::vector<int> result(range_size, 1);
+    return result;
+}
+
+void raw_iterator(benchmark::state& state)
+{
+    std::vector<int>& v = make_range();
+    while(state.keep_running()) {
+        int sum = 0;
+        for(std::vector<int>::iterator i = v.begin(), end = v.end(); i != end; ++i) {
+            sum += *i;
+        }
+        benchmark::do_not_optimize(sum);
+    }
+}
+
+void virtual_iterator(benchmark::state& state)
+{
+    typedef int_iterator<std::vector<int>::iterator> iterator_type;
+    std::vector<int>& v = make_range();
+    while(state.keep_running()) {
+        std::unique_ptr<int_iterator_base> i(new iterator_type(v.begin()));
+        std::unique_ptr<int_iterator_base> end(new iterator_type(v.end()));
+        int sum = 0;
+        for(; !i->equal(*end); i->increment()) {
+            sum += i->dereference();
+        }
+        benchmark::do_not_optimize(sum);
+    }
+}
+
+void std_function_generator(benchmark::state& state)
+{
+    std::vector<int>& v = make_range();
+    while(state.keep_running()) {
+        std::vector<int>::iterator pos = v.begin();
+        std::function<const int*()> next = [&]() -> const int* { return pos == v.end()? 0 : &*pos++; };
+        int sum = 0;
+        while(const int* p = next()) {
+            sum += *p;
+        }
+        benchmark::do_not_optimize(sum);
+    }
+}
+
+void any_iterator_(benchmark::state& state)
+{
+    std::vector<int>& v = make_range();
+    while(state.keep_running()) {
+        int sum = 0;
+        for(any_iterator i(v.begin()), end(v.end()); i != end; ++i) {
+            sum += *i;
+        }
+        benchmark::do_not_optimize(sum);
+    }
+}
+
+void any_iterator_copy(benchmark::state& state)
+{
+    std::vector<int>& v = make_range();
+    any_iterator i(v.begin());
+    while(state.keep_running()) {
+        any_iterator j(i);
+        benchmark::do_not_optimize(j);
+    }
+}
+
+typedef te::any<
+    boost::mpl::vector<
+        te::copy_constructible<>,
+        te::block_readable<int>
+    >
+> any_block_range;
+
+void any_block_range_(benchmark::state& state)
+{
+    std::vector<int>& v = make_range();
+    int buffer[256];
+    while(state.keep_running()) {
+        any_block_range source(te::make_block_range(v.begin(), v.end()));
+        int sum = 0;
+        while(std::size_t n = source.next_block(buffer, 256)) {
+            for(std::size_t i = 0; i < n; ++i) {
+                sum += buffer[i];
+            }
+        }
+        benchmark::do_not_optimize(sum);
+    }
+}
+
+typedef te::any<
+    boost::mpl::vector<
+        te::random_access_iterator<>,
+        te::same_type<te::random_access_iterator<>::value_type, int>,
+        te::contiguous_iterator<int>
+    >
+> any_contiguous_iterator;
+
+void any_contiguous_iterator_(benchmark::state& state)
+{
+    std::vector<int>& v = make_range();
+    while(state.keep_running()) {
+        any_contiguous_iterator first(v.begin()), last(v.end());
+        int sum = 0;
+        if(const int* p = first.contiguous_data()) {
+            for(std::ptrdiff_t i = 0, n = last - first; i < n; ++i) {
+                sum += p[i];
+            }
+        } else {
+            for(; first != last; ++first) {
+                sum += *first;
+            }
+        }
+        benchmark::do_not_optimize(sum);
+    }
+}
+
+BENCHMARK(raw_iterator);
+BENCHMARK(virtual_iterator);
+BENCHMARK(std_function_generator);
+BENCHMARK(any_iterator_);
+BENCHMARK(any_iterator_copy);
+BENCHMARK(any_block_range_);
+BENCHMARK(any_contiguous_iterator_);
+
+BENCHMARK_MAIN()
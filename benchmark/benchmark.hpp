@@ -0,0 +1,144 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#ifndef BOOST_TYPE_ERASURE_BENCHMARK_BENCHMARK_HPP_INCLUDED
+#define BOOST_TYPE_ERASURE_BENCHMARK_BENCHMARK_HPP_INCLUDED
+
+// A minimal harness in the style of Google Benchmark.
+// Each benchmark is a function taking a state&, which
+// runs the timed loop with
+//
+//   while(state.keep_running()) { ... }
+//
+// The harness picks the number of iterations so that each
+// benchmark runs for at least min_time, and prints the time
+// per iteration.  Passing a string on the command line runs
+// only the benchmarks whose name contains it.
+
+#include <boost/config.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// <any> may exist, but be empty, before C++17.
+#if !defined(BOOST_NO_CXX17_HDR_ANY) && \
+    (__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+#define BENCHMARK_HAS_STD_ANY
+#endif
+
+namespace benchmark {
+
+/** Prevents the compiler from discarding a computed value. */
+template<class T>
+inline void do_not_optimize(T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __asm__ __volatile__("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+class state
+{
+public:
+    explicit state(std::size_t iterations) : _remaining(iterations) {}
+    bool keep_running() { return _remaining-- != 0; }
+private:
+    std::size_t _remaining;
+};
+
+typedef void (*function_type)(state&);
+
+struct entry
+{
+    const char* name;
+    function_type function;
+};
+
+inline std::vector<entry>& registry()
+{
+    static std::vector<entry> result;
+    return result;
+}
+
+struct registrar
+{
+    registrar(const char* name, function_type f)
+    {
+        entry e = { name, f };
+        registry().push_back(e);
+    }
+};
+
+inline double run_one(function_type f, std::size_t iterations)
+{
+    typedef std::chrono::steady_clock clock_type;
+    state s(iterations);
+    clock_type::time_point start = clock_type::now();
+    f(s);
+    clock_type::time_point finish = clock_type::now();
+    return std::chrono::duration<double>(finish - start).count();
+}
+
+inline int run_all(int argc, char** argv)
+{
+    const double min_time = 0.2;
+    const char* filter = argc > 1? argv[1] : "";
+    std::printf("%-56s %14s %14s\n", "Benchmark", "Time (ns)", "Iterations");
+    std::printf("%s\n", std::string(86, '-').c_str());
+    const std::vector<entry>& benchmarks = registry();
+    for(std::size_t i = 0; i < benchmarks.size(); ++i) {
+        if(std::strstr(benchmarks[i].name, filter) == 0) continue;
+        std::size_t iterations = 1;
+        double elapsed = run_one(benchmarks[i].function, iterations);
+        while(elapsed < min_time && iterations < (std::size_t(1) << 40)) {
+            // Aim for 1.5 * min_time, but grow by at most 100x at a time.
+            double ratio = elapsed > 0? min_time * 1.5 / elapsed : 100;
+            std::size_t next = static_cast<std::size_t>(iterations * (ratio < 100? ratio : 100));
+            iterations = next > iterations? next : iterations + 1;
+            elapsed = run_one(benchmarks[i].function, iterations);
+        }
+        std::printf("%-56s %14.2f %14lu\n", benchmarks[i].name,
+            elapsed * 1e9 / iterations, static_cast<unsigned long>(iterations));
+    }
+    return 0;
+}
+
+/**
+ * A payload of a given size, used to compare
+ * objects that fit in a small buffer with
+ * objects that do not.
+ */
+template<std::size_t N>
+struct payload
+{
+    explicit payload(int v = 0) { std::memset(data, 0, N); std::memcpy(data, &v, sizeof(int)); }
+    int get() const { int result; std::memcpy(&result, data, sizeof(int)); return result; }
+    unsigned char data[N];
+};
+
+}
+
+#define BENCHMARK_CAT_I(x, y) x ## y
+#define BENCHMARK_CAT(x, y) BENCHMARK_CAT_I(x, y)
+
+/** Registers a function taking a benchmark::state&. */
+#define BENCHMARK(...)                                          \
+    static ::benchmark::registrar BENCHMARK_CAT(benchmark_registrar_, __LINE__)(#__VA_ARGS__, &__VA_ARGS__)
+
+#define BENCHMARK_MAIN()                                        \
+    int main(int argc, char** argv) { return ::benchmark::run_all(argc, argv); }
+
+#endif
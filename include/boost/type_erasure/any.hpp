@@ -39,6 +39,7 @@
 #include <boost/type_erasure/detail/any_base.hpp>
 #include <boost/type_erasure/detail/normalize.hpp>
 #include <boost/type_erasure/detail/storage.hpp>
+#include <boost/type_erasure/detail/type_token.hpp>
 #include <boost/type_erasure/detail/instantiate.hpp>
 #include <boost/type_erasure/config.hpp>
 #include <boost/type_erasure/binding.hpp>
@@ -46,6 +47,9 @@
 #include <boost/type_erasure/concept_interface.hpp>
 #include <boost/type_erasure/call.hpp>
 #include <boost/type_erasure/relaxed.hpp>
+#include <boost/type_erasure/in_place.hpp>
+#include <boost/type_erasure/detail/storage_of.hpp>
+#include <boost/type_erasure/detail/intrusive_storage.hpp>
 #include <boost/type_erasure/param.hpp>
 
 #ifdef BOOST_MSVC
@@ -194,6 +198,17 @@ struct is_any : ::boost::mpl::false_ {};
 template<class Concept, class T>
 struct is_any<any<Concept, T> > : ::boost::mpl::true_ {};
 
+// Moving a value any only hands over the object, without
+// constructing anything, if the source may be left empty
+// or may keep sharing the object.
+template<class Concept>
+struct has_nothrow_move :
+    ::boost::mpl::or_<
+        ::boost::type_erasure::is_relaxed<Concept>,
+        ::boost::type_erasure::detail::is_copy_on_write<Concept>
+    >
+{};
+
 #ifdef BOOST_TYPE_ERASURE_SFINAE_FRIENDLY_CONSTRUCTORS
 
 template<class Any, class... U>
@@ -295,6 +310,41 @@ struct safe_placeholder_of<any<Concept, T> const&> { typedef T type; };
 template<class T>
 using safe_placeholder_t = ::boost::remove_cv_t< ::boost::remove_reference_t<typename safe_placeholder_of<T>::type> >;
 
+template<class T, class Table>
+void swap_storage(
+    ::boost::type_erasure::detail::storage& lhs, const Table&,
+    ::boost::type_erasure::detail::storage& rhs, const Table&)
+{
+    ::std::swap(lhs, rhs);
+}
+
+// Objects in the buffer cannot simply trade places, so they
+// are moved through a temporary buffer.
+template<class T, class Table, std::size_t Size, std::size_t Align, class Alloc>
+void swap_storage(
+    ::boost::type_erasure::detail::managed_storage<Size, Align, Alloc>& lhs, const Table& lhs_table,
+    ::boost::type_erasure::detail::managed_storage<Size, Align, Alloc>& rhs, const Table& rhs_table)
+{
+    ::boost::type_erasure::detail::managed_storage<Size, Align, void> tmp;
+    const ::boost::type_erasure::detail::object_traits& lhs_traits =
+        lhs_table.template find_traits<T>();
+    const ::boost::type_erasure::detail::object_traits& rhs_traits =
+        rhs_table.template find_traits<T>();
+    if(!::boost::type_erasure::detail::relocate_trivial(tmp, lhs, lhs_traits)) {
+        lhs_table.template find< ::boost::type_erasure::destructible<T> >()(
+            lhs, lhs.data_space(), &tmp, tmp.space());
+    }
+    if(!::boost::type_erasure::detail::relocate_trivial(lhs, rhs, rhs_traits)) {
+        rhs_table.template find< ::boost::type_erasure::destructible<T> >()(
+            rhs, rhs.data_space(), &lhs, lhs.space());
+    }
+    if(!::boost::type_erasure::detail::relocate_trivial(rhs, tmp, lhs_traits)) {
+        lhs_table.template find< ::boost::type_erasure::destructible<T> >()(
+            tmp, tmp.space(), &rhs, rhs.space());
+    }
+    lhs.swap_allocator(rhs);
+}
+
 }
 
 // Enables or deletes the copy/move constructors depending on the Concept.
@@ -380,8 +430,12 @@ struct any_constructor_control<
     any_constructor_control& operator=(any_constructor_control &&) = default;
 };
 
+template<class Concept, class T,
+    bool Intrusive = ::boost::type_erasure::detail::is_intrusive<Concept>::value>
+struct any_constructor_impl;
+
 template<class Concept, class T>
-struct any_constructor_impl :
+struct any_constructor_impl<Concept, T, false> :
     ::boost::type_erasure::detail::compute_bases<
         ::boost::type_erasure::any<Concept, T>,
         Concept,
@@ -403,6 +457,16 @@ struct any_constructor_impl :
       : _boost_type_erasure_table(table_arg),
         _boost_type_erasure_data(data_arg)
     {}
+    // Places the result of a call in the storage of the any.
+    template<class Impl, class F, class Guess, class... U>
+    any_constructor_impl(::boost::type_erasure::detail::result_in_place<Impl, F, Guess>,
+        const _boost_type_erasure_table_type& table_arg, U&&... u)
+      : _boost_type_erasure_table(table_arg)
+    {
+        _boost_type_erasure_data = Impl::template apply_in<F, Guess>(
+            ::boost::type_erasure::detail::get_space(_boost_type_erasure_data),
+            &table_arg, std::forward<U>(u)...);
+    }
     // default constructor
     any_constructor_impl()
     {
@@ -414,7 +478,8 @@ struct any_constructor_impl :
         typename ::boost::enable_if_c<
             !::boost::type_erasure::detail::is_any_arg<U>::value &&
             !::boost::type_erasure::detail::is_binding_arg<U>::value &&
-            !::boost::type_erasure::detail::is_static_binding_arg<U>::value
+            !::boost::type_erasure::detail::is_static_binding_arg<U>::value &&
+            !::boost::type_erasure::detail::is_in_place_arg<U>::value
         >::type* = nullptr
     >
     any_constructor_impl(U&& data_arg)
@@ -430,7 +495,8 @@ struct any_constructor_impl :
         typename ::boost::enable_if_c<
             !::boost::type_erasure::detail::is_any_arg<U>::value &&
             !::boost::type_erasure::detail::is_binding_arg<U>::value &&
-            !::boost::type_erasure::detail::is_static_binding_arg<U>::value
+            !::boost::type_erasure::detail::is_static_binding_arg<U>::value &&
+            !::boost::type_erasure::detail::is_in_place_arg<U>::value
         >::type* = nullptr
     >
     any_constructor_impl(U&& data_arg, const static_binding<Map>& b)
@@ -443,6 +509,38 @@ struct any_constructor_impl :
         BOOST_MPL_ASSERT((::boost::is_same<
             typename ::boost::mpl::at<Map, T>::type, ::boost::decay_t<U> >));
     }
+    template<class A, class U,
+        typename ::boost::enable_if_c<
+            ::boost::type_erasure::detail::has_allocator<Concept>::value &&
+            !::boost::type_erasure::detail::is_any_arg<U>::value &&
+            !::boost::type_erasure::detail::is_binding_arg<U>::value &&
+            !::boost::type_erasure::detail::is_static_binding_arg<U>::value &&
+            !::boost::type_erasure::detail::is_in_place_arg<U>::value
+        >::type* = nullptr
+    >
+    any_constructor_impl(::std::allocator_arg_t, const A& alloc, U&& data_arg)
+      : _boost_type_erasure_table((
+            BOOST_TYPE_ERASURE_INSTANTIATE1(Concept, T, ::boost::decay_t<U>),
+            ::boost::type_erasure::make_binding<
+                ::boost::mpl::map1< ::boost::mpl::pair<T, ::boost::decay_t<U> > >
+            >()
+        )),
+        _boost_type_erasure_data(::std::allocator_arg, alloc, std::forward<U>(data_arg))
+    {}
+    // in-place constructor
+    template<class U, class... A>
+    explicit any_constructor_impl(::boost::type_erasure::in_place_type_t<U>, A&&... arg)
+      : _boost_type_erasure_table((
+            BOOST_TYPE_ERASURE_INSTANTIATE1(Concept, T, U),
+            ::boost::type_erasure::make_binding<
+                ::boost::mpl::map1< ::boost::mpl::pair<T, U> >
+            >()
+        ))
+    {
+        _boost_type_erasure_data = ::boost::type_erasure::detail::construct_value<U>(
+            ::boost::type_erasure::detail::get_space(_boost_type_erasure_data),
+            std::forward<A>(arg)...);
+    }
     // converting constructor
     template<class U,
         typename ::boost::enable_if_c<
@@ -473,26 +571,28 @@ struct any_constructor_impl :
                     >
                 >
             >::type()
-        ),
-        _boost_type_erasure_data(::boost::type_erasure::call(
+        )
+    {
+        _boost_type_erasure_data = ::boost::type_erasure::detail::construct_in(
+            ::boost::type_erasure::detail::get_space(_boost_type_erasure_data),
             ::boost::type_erasure::detail::make(
                 false? other._boost_type_erasure_deduce_constructor(std::forward<U>(other)) : 0
-            ), std::forward<U>(other))
-        )
-    {}
+            ), std::forward<U>(other));
+    }
     template<class U,
         typename ::boost::enable_if_c<
             ::boost::type_erasure::detail::is_any_arg<U>::value
         >::type* = nullptr
     >
     any_constructor_impl(U&& other, const binding<Concept>& binding_arg)
-      : _boost_type_erasure_table(binding_arg),
-        _boost_type_erasure_data(::boost::type_erasure::call(
+      : _boost_type_erasure_table(binding_arg)
+    {
+        _boost_type_erasure_data = ::boost::type_erasure::detail::construct_in(
+            ::boost::type_erasure::detail::get_space(_boost_type_erasure_data),
             ::boost::type_erasure::detail::make(
                 false? other._boost_type_erasure_deduce_constructor(std::forward<U>(other)) : 0
-            ), std::forward<U>(other))
-        )
-    {}
+            ), std::forward<U>(other));
+    }
     template<class U, class Map,
         typename ::boost::enable_if_c<
             ::boost::type_erasure::is_subconcept<
@@ -502,48 +602,64 @@ struct any_constructor_impl :
         >::type* = nullptr
     >
     any_constructor_impl(U&& other, const static_binding<Map>& binding_arg)
-      : _boost_type_erasure_table(::boost::type_erasure::detail::access::table(other), binding_arg),
-        _boost_type_erasure_data(::boost::type_erasure::call(
+      : _boost_type_erasure_table(::boost::type_erasure::detail::access::table(other), binding_arg)
+    {
+        _boost_type_erasure_data = ::boost::type_erasure::detail::construct_in(
+            ::boost::type_erasure::detail::get_space(_boost_type_erasure_data),
             ::boost::type_erasure::detail::make(
                 false? other._boost_type_erasure_deduce_constructor(std::forward<U>(other)) : 0
-            ), std::forward<U>(other))
-        )
-    {}
+            ), std::forward<U>(other));
+    }
     // copy and move constructors are a special case of the converting
     // constructors, but must be defined separately to keep C++ happy.
     any_constructor_impl(const any_constructor_impl& other)
       : _boost_type_erasure_table(
             ::boost::type_erasure::detail::access::table(other)
-        ),
-        _boost_type_erasure_data(::boost::type_erasure::call(
+        )
+    {
+        ::boost::type_erasure::detail::copy_allocator(
+            _boost_type_erasure_data, other._boost_type_erasure_data);
+        if(::boost::type_erasure::detail::copy_trivial(
+            _boost_type_erasure_data, other._boost_type_erasure_data,
+            _boost_type_erasure_table.template find_traits<T>()))
+        {
+            return;
+        }
+        _boost_type_erasure_data = ::boost::type_erasure::detail::construct_in(
+            ::boost::type_erasure::detail::get_space(_boost_type_erasure_data),
             ::boost::type_erasure::detail::make(
                 false? other._boost_type_erasure_deduce_constructor(
                     static_cast<typename _boost_type_erasure_base::_boost_type_erasure_derived_type const&>(other)) : 0
-            ), other)
-        )
-    {}
+            ), other);
+    }
     any_constructor_impl(any_constructor_impl& other)
       : _boost_type_erasure_table(
             ::boost::type_erasure::detail::access::table(other)
-        ),
-        _boost_type_erasure_data(::boost::type_erasure::call(
+        )
+    {
+        ::boost::type_erasure::detail::copy_allocator(
+            _boost_type_erasure_data, other._boost_type_erasure_data);
+        if(::boost::type_erasure::detail::copy_trivial(
+            _boost_type_erasure_data, other._boost_type_erasure_data,
+            _boost_type_erasure_table.template find_traits<T>()))
+        {
+            return;
+        }
+        _boost_type_erasure_data = ::boost::type_erasure::detail::construct_in(
+            ::boost::type_erasure::detail::get_space(_boost_type_erasure_data),
             ::boost::type_erasure::detail::make(
                 false? other._boost_type_erasure_deduce_constructor(
                     static_cast<typename _boost_type_erasure_base::_boost_type_erasure_derived_type &>(other)) : 0
-            ), other)
-        )
-    {}
+            ), other);
+    }
     any_constructor_impl(any_constructor_impl&& other)
+        BOOST_NOEXCEPT_IF(::boost::type_erasure::detail::has_nothrow_move<Concept>::value)
       : _boost_type_erasure_table(
             ::boost::type_erasure::detail::access::table(other)
-        ),
-        _boost_type_erasure_data(::boost::type_erasure::call(
-            ::boost::type_erasure::detail::make(
-                false? other._boost_type_erasure_deduce_constructor(
-                    static_cast<typename _boost_type_erasure_base::_boost_type_erasure_derived_type &&>(other)) : 0
-            ), std::move(other))
         )
-    {}
+    {
+        _boost_type_erasure_move_from(other, ::boost::type_erasure::is_relaxed<Concept>());
+    }
 
     template<class R, class... A, class... U>
     const _boost_type_erasure_table_type& _boost_type_erasure_extract_table(
@@ -564,33 +680,31 @@ struct any_constructor_impl :
                 false? this->_boost_type_erasure_deduce_constructor(std::forward<U>(u)...) : 0,
                 std::forward<U>(u)...
             )
-        ),
-        _boost_type_erasure_data(
-            ::boost::type_erasure::call(
-                ::boost::type_erasure::detail::make(
-                    false? this->_boost_type_erasure_deduce_constructor(std::forward<U>(u)...) : 0
-                ),
-                std::forward<U>(u)...
-            )
         )
-    {}
+    {
+        _boost_type_erasure_data = ::boost::type_erasure::detail::construct_in(
+            ::boost::type_erasure::detail::get_space(_boost_type_erasure_data),
+            ::boost::type_erasure::detail::make(
+                false? this->_boost_type_erasure_deduce_constructor(std::forward<U>(u)...) : 0
+            ),
+            std::forward<U>(u)...);
+    }
     template<class... U,
         typename ::boost::enable_if_c<
             ::boost::type_erasure::detail::has_constructor<any_constructor_impl, U...>::value
         >::type* = nullptr
     >
     explicit any_constructor_impl(const binding<Concept>& binding_arg, U&&... u)
-      : _boost_type_erasure_table(binding_arg),
-        _boost_type_erasure_data(
-            ::boost::type_erasure::call(
-                binding_arg,
-                ::boost::type_erasure::detail::make(
-                    false? this->_boost_type_erasure_deduce_constructor(std::forward<U>(u)...) : 0
-                ),
-                std::forward<U>(u)...
-            )
-        )
-    {}
+      : _boost_type_erasure_table(binding_arg)
+    {
+        _boost_type_erasure_data = ::boost::type_erasure::detail::construct_in(
+            ::boost::type_erasure::detail::get_space(_boost_type_erasure_data),
+            binding_arg,
+            ::boost::type_erasure::detail::make(
+                false? this->_boost_type_erasure_deduce_constructor(std::forward<U>(u)...) : 0
+            ),
+            std::forward<U>(u)...);
+    }
 
     // The assignment operator and destructor must be defined here rather
     // than in any to avoid implicitly deleting the move constructor.
@@ -618,16 +732,588 @@ struct any_constructor_impl :
 
     ~any_constructor_impl()
     {
+        _boost_type_erasure_destroy();
+    }
+
+protected:
+    friend struct ::boost::type_erasure::detail::access;
+
+    void _boost_type_erasure_destroy()
+    {
+        if(::boost::type_erasure::detail::destroy_trivial(
+            _boost_type_erasure_data, _boost_type_erasure_table.template find_traits<T>()))
+        {
+            return;
+        }
         _boost_type_erasure_table.template find<
             ::boost::type_erasure::destructible<T>
-        >()(_boost_type_erasure_data);
+        >()(_boost_type_erasure_data,
+            ::boost::type_erasure::detail::get_data_space(_boost_type_erasure_data),
+            0, ::boost::type_erasure::detail::storage_space());
+    }
+
+    // A relaxed any may be left empty, so it can give
+    // away the object that it holds.
+    void _boost_type_erasure_move_from(any_constructor_impl& other, ::boost::mpl::true_)
+    {
+        if(!::boost::type_erasure::detail::relocate_trivial(
+            _boost_type_erasure_data, other._boost_type_erasure_data,
+            _boost_type_erasure_table.template find_traits<T>()))
+        {
+            other._boost_type_erasure_table.template find<
+                ::boost::type_erasure::destructible<T>
+            >()(other._boost_type_erasure_data,
+                ::boost::type_erasure::detail::get_data_space(other._boost_type_erasure_data),
+                &_boost_type_erasure_data,
+                ::boost::type_erasure::detail::get_space(_boost_type_erasure_data));
+        }
+        ::boost::type_erasure::detail::take_allocator(
+            _boost_type_erasure_data, other._boost_type_erasure_data);
+        other._boost_type_erasure_table = _boost_type_erasure_table_type();
+        other._boost_type_erasure_data.data = 0;
+    }
+    void _boost_type_erasure_move_from(any_constructor_impl& other, ::boost::mpl::false_)
+    {
+        ::boost::type_erasure::detail::copy_allocator(
+            _boost_type_erasure_data, other._boost_type_erasure_data);
+        if(::boost::type_erasure::detail::copy_trivial(
+            _boost_type_erasure_data, other._boost_type_erasure_data,
+            _boost_type_erasure_table.template find_traits<T>()))
+        {
+            return;
+        }
+        _boost_type_erasure_data = ::boost::type_erasure::detail::construct_in(
+            ::boost::type_erasure::detail::get_space(_boost_type_erasure_data),
+            ::boost::type_erasure::detail::make(
+                false? other._boost_type_erasure_deduce_constructor(
+                    static_cast<typename _boost_type_erasure_base::_boost_type_erasure_derived_type &&>(other)) : 0
+            ), std::move(other));
+    }
+    // Replaces the object with the one held by a relaxed
+    // other.  Destroying the old object and relocating the
+    // new one cannot throw, so this needs no temporary.
+    void _boost_type_erasure_move_assign(any_constructor_impl& other)
+    {
+        if(this == &other) {
+            return;
+        }
+        _boost_type_erasure_destroy();
+        _boost_type_erasure_table = other._boost_type_erasure_table;
+        _boost_type_erasure_move_from(other, ::boost::mpl::true_());
+    }
+
+    // The object may be modified without affecting other anys.
+    bool _boost_type_erasure_is_unique() const { return true; }
+
+    void _boost_type_erasure_swap_impl(any_constructor_impl& other)
+    {
+        ::boost::type_erasure::detail::swap_storage<T>(
+            _boost_type_erasure_data, _boost_type_erasure_table,
+            other._boost_type_erasure_data, other._boost_type_erasure_table);
+        ::std::swap(_boost_type_erasure_table, other._boost_type_erasure_table);
+    }
+
+    const _boost_type_erasure_table_type& _boost_type_erasure_get_table() const
+    { return _boost_type_erasure_table; }
+    // Used when the object was replaced by one of the same type.
+    void _boost_type_erasure_set_table(const _boost_type_erasure_table_type& table_arg)
+    { _boost_type_erasure_table = table_arg; }
+    ::boost::type_erasure::detail::storage& _boost_type_erasure_get_data()
+    { return _boost_type_erasure_data; }
+    const ::boost::type_erasure::detail::storage& _boost_type_erasure_get_data() const
+    { return _boost_type_erasure_data; }
+
+    typedef typename ::boost::type_erasure::detail::storage_of<Concept>::type _boost_type_erasure_storage_type;
+
+    _boost_type_erasure_table_type _boost_type_erasure_table;
+    _boost_type_erasure_storage_type _boost_type_erasure_data;
+};
+
+// With intrusive, the any holds a single pointer to a
+// heap block containing the binding and the storage.  An
+// object constructed by the any is placed in the same
+// allocation, directly after the block.  With
+// copy_on_write, copies share the block, which is
+// cloned before the object is accessed through a
+// non-const any.
+template<class Concept, class T>
+struct any_constructor_impl<Concept, T, true> :
+    ::boost::type_erasure::detail::compute_bases<
+        ::boost::type_erasure::any<Concept, T>,
+        Concept,
+        T
+    >::type
+{
+    typedef typename ::boost::type_erasure::detail::compute_bases<
+        ::boost::type_erasure::any<Concept, T>,
+        Concept,
+        T
+    >::type _boost_type_erasure_base;
+    typedef ::boost::type_erasure::binding<Concept> _boost_type_erasure_table_type;
+    typedef ::boost::type_erasure::detail::is_copy_on_write<Concept> _boost_type_erasure_shared;
+    typedef ::boost::type_erasure::detail::intrusive_block<
+        _boost_type_erasure_table_type,
+        _boost_type_erasure_shared::value
+    > _boost_type_erasure_block_type;
+    typedef ::boost::type_erasure::detail::intrusive_allocation<
+        _boost_type_erasure_block_type> _boost_type_erasure_allocation;
+    // Internal constructors
+    any_constructor_impl(const ::boost::type_erasure::detail::storage& data_arg, const _boost_type_erasure_table_type& table_arg)
+    {
+        _boost_type_erasure_adopt(table_arg, data_arg);
+    }
+    // Places the result of a call in the same block as the binding.
+    template<class Impl, class F, class Guess, class... U>
+    any_constructor_impl(::boost::type_erasure::detail::result_in_place<Impl, F, Guess>,
+        const _boost_type_erasure_table_type& table_arg, U&&... u)
+    {
+        _boost_type_erasure_allocation memory;
+        ::boost::type_erasure::detail::storage data_arg =
+            Impl::template apply_in<F, Guess>(memory.space(), &table_arg, std::forward<U>(u)...);
+        _boost_type_erasure_init(table_arg, memory, data_arg);
+    }
+    // default constructor
+    any_constructor_impl()
+      : _boost_type_erasure_block(_boost_type_erasure_empty_block())
+    {}
+    // capturing constructor
+    template<class U,
+        typename ::boost::enable_if_c<
+            !::boost::type_erasure::detail::is_any_arg<U>::value &&
+            !::boost::type_erasure::detail::is_binding_arg<U>::value &&
+            !::boost::type_erasure::detail::is_static_binding_arg<U>::value &&
+            !::boost::type_erasure::detail::is_in_place_arg<U>::value
+        >::type* = nullptr
+    >
+    any_constructor_impl(U&& data_arg)
+    {
+        _boost_type_erasure_capture< ::boost::decay_t<U> >(
+            _boost_type_erasure_table_type((
+                BOOST_TYPE_ERASURE_INSTANTIATE1(Concept, T, ::boost::decay_t<U>),
+                ::boost::type_erasure::make_binding<
+                    ::boost::mpl::map1< ::boost::mpl::pair<T, ::boost::decay_t<U> > >
+                >()
+            )),
+            std::forward<U>(data_arg));
+    }
+    template<class U, class Map,
+        typename ::boost::enable_if_c<
+            !::boost::type_erasure::detail::is_any_arg<U>::value &&
+            !::boost::type_erasure::detail::is_binding_arg<U>::value &&
+            !::boost::type_erasure::detail::is_static_binding_arg<U>::value &&
+            !::boost::type_erasure::detail::is_in_place_arg<U>::value
+        >::type* = nullptr
+    >
+    any_constructor_impl(U&& data_arg, const static_binding<Map>& b)
+    {
+        BOOST_MPL_ASSERT((::boost::is_same<
+            typename ::boost::mpl::at<Map, T>::type, ::boost::decay_t<U> >));
+        _boost_type_erasure_capture< ::boost::decay_t<U> >(
+            _boost_type_erasure_table_type((
+                BOOST_TYPE_ERASURE_INSTANTIATE(Concept, Map),
+                b
+            )),
+            std::forward<U>(data_arg));
+    }
+    // in-place constructor
+    template<class U, class... A>
+    explicit any_constructor_impl(::boost::type_erasure::in_place_type_t<U>, A&&... arg)
+    {
+        _boost_type_erasure_capture<U>(
+            _boost_type_erasure_table_type((
+                BOOST_TYPE_ERASURE_INSTANTIATE1(Concept, T, U),
+                ::boost::type_erasure::make_binding<
+                    ::boost::mpl::map1< ::boost::mpl::pair<T, U> >
+                >()
+            )),
+            std::forward<A>(arg)...);
+    }
+    // converting constructor
+    template<class U,
+        typename ::boost::enable_if_c<
+            ::boost::type_erasure::is_subconcept<
+                Concept, typename ::boost::type_erasure::detail::safe_concept_of<U>::type,
+                typename ::boost::mpl::if_c< ::boost::is_same<T, ::boost::type_erasure::detail::safe_placeholder_t<U> >::value,
+                    void,
+                    ::boost::mpl::map1<
+                        ::boost::mpl::pair<T, ::boost::type_erasure::detail::safe_placeholder_t<U> >
+                    >
+                >::type
+            >::value
+        >::type* = nullptr
+    >
+    any_constructor_impl(U&& other)
+    {
+        _boost_type_erasure_convert(std::forward<U>(other),
+            ::boost::mpl::bool_<
+                _boost_type_erasure_shared::value &&
+                ::boost::is_same< ::boost::decay_t<U>, ::boost::type_erasure::any<Concept, T> >::value
+            >());
+    }
+    template<class U,
+        typename ::boost::enable_if_c<
+            ::boost::type_erasure::detail::is_any_arg<U>::value
+        >::type* = nullptr
+    >
+    any_constructor_impl(U&& other, const binding<Concept>& binding_arg)
+    {
+        _boost_type_erasure_construct(
+            binding_arg,
+            ::boost::type_erasure::detail::make(
+                false? other._boost_type_erasure_deduce_constructor(std::forward<U>(other)) : 0
+            ), std::forward<U>(other));
+    }
+    template<class U, class Map,
+        typename ::boost::enable_if_c<
+            ::boost::type_erasure::is_subconcept<
+                Concept, typename ::boost::type_erasure::detail::safe_concept_of<U>::type,
+                Map
+            >::value
+        >::type* = nullptr
+    >
+    any_constructor_impl(U&& other, const static_binding<Map>& binding_arg)
+    {
+        _boost_type_erasure_construct(
+            _boost_type_erasure_table_type(::boost::type_erasure::detail::access::table(other), binding_arg),
+            ::boost::type_erasure::detail::make(
+                false? other._boost_type_erasure_deduce_constructor(std::forward<U>(other)) : 0
+            ), std::forward<U>(other));
+    }
+    // copy and move constructors are a special case of the converting
+    // constructors, but must be defined separately to keep C++ happy.
+    any_constructor_impl(const any_constructor_impl& other)
+    {
+        _boost_type_erasure_copy_from(other, _boost_type_erasure_shared());
+    }
+    any_constructor_impl(any_constructor_impl& other)
+    {
+        _boost_type_erasure_copy_from(other, _boost_type_erasure_shared());
+    }
+    any_constructor_impl(any_constructor_impl&& other)
+        BOOST_NOEXCEPT_IF(::boost::type_erasure::detail::has_nothrow_move<Concept>::value)
+    {
+        _boost_type_erasure_move_from(other, ::boost::type_erasure::is_relaxed<Concept>());
+    }
+
+    template<class R, class... A, class... U>
+    const _boost_type_erasure_table_type& _boost_type_erasure_extract_table(
+        ::boost::type_erasure::constructible<R(A...)>*,
+        U&&... u)
+    {
+        return *::boost::type_erasure::detail::extract_table(static_cast<void(*)(A...)>(0), u...);
+    }
+    // forwarding constructor
+    template<class... U,
+        typename ::boost::enable_if_c<
+            ::boost::type_erasure::detail::has_constructor<any_constructor_impl, U...>::value
+        >::type* = nullptr
+    >
+    explicit any_constructor_impl(U&&... u)
+    {
+        _boost_type_erasure_construct(
+            _boost_type_erasure_extract_table(
+                false? this->_boost_type_erasure_deduce_constructor(std::forward<U>(u)...) : 0,
+                std::forward<U>(u)...
+            ),
+            ::boost::type_erasure::detail::make(
+                false? this->_boost_type_erasure_deduce_constructor(std::forward<U>(u)...) : 0
+            ),
+            std::forward<U>(u)...);
+    }
+    template<class... U,
+        typename ::boost::enable_if_c<
+            ::boost::type_erasure::detail::has_constructor<any_constructor_impl, U...>::value
+        >::type* = nullptr
+    >
+    explicit any_constructor_impl(const binding<Concept>& binding_arg, U&&... u)
+    {
+        _boost_type_erasure_construct(
+            binding_arg,
+            binding_arg,
+            ::boost::type_erasure::detail::make(
+                false? this->_boost_type_erasure_deduce_constructor(std::forward<U>(u)...) : 0
+            ),
+            std::forward<U>(u)...);
+    }
+
+    // The assignment operator and destructor must be defined here rather
+    // than in any to avoid implicitly deleting the move constructor.
+
+    any_constructor_impl& operator=(const any_constructor_impl& other)
+    {
+        static_cast<typename _boost_type_erasure_base::_boost_type_erasure_derived_type*>(this)->_boost_type_erasure_resolve_assign(
+            static_cast<const typename _boost_type_erasure_base::_boost_type_erasure_derived_type&>(other));
+        return *this;
+    }
+
+    any_constructor_impl& operator=(any_constructor_impl& other)
+    {
+        static_cast<typename _boost_type_erasure_base::_boost_type_erasure_derived_type*>(this)->_boost_type_erasure_resolve_assign(
+            static_cast<typename _boost_type_erasure_base::_boost_type_erasure_derived_type&>(other));
+        return *this;
+    }
+
+    any_constructor_impl& operator=(any_constructor_impl&& other)
+    {
+        static_cast<typename _boost_type_erasure_base::_boost_type_erasure_derived_type*>(this)->_boost_type_erasure_resolve_assign(
+            static_cast<typename _boost_type_erasure_base::_boost_type_erasure_derived_type&&>(other));
+        return *this;
+    }
+
+    ~any_constructor_impl()
+    {
+        _boost_type_erasure_release_block(_boost_type_erasure_block);
     }
 
 protected:
     friend struct ::boost::type_erasure::detail::access;
 
-    _boost_type_erasure_table_type _boost_type_erasure_table;
-    ::boost::type_erasure::detail::storage _boost_type_erasure_data;
+    // Destroys an object that has no block yet, if
+    // allocating the block fails.
+    struct _boost_type_erasure_adopt_guard
+    {
+        _boost_type_erasure_adopt_guard(const _boost_type_erasure_table_type& table_arg,
+            const ::boost::type_erasure::detail::storage& data_arg)
+          : table(&table_arg), data(data_arg) {}
+        ~_boost_type_erasure_adopt_guard()
+        {
+            if(table) {
+                table->template find<
+                    ::boost::type_erasure::destructible<T>
+                >()(data, ::boost::type_erasure::detail::storage_space(),
+                    0, ::boost::type_erasure::detail::storage_space());
+            }
+        }
+        const _boost_type_erasure_table_type* table;
+        ::boost::type_erasure::detail::storage data;
+    };
+
+    void _boost_type_erasure_adopt(const _boost_type_erasure_table_type& table_arg,
+        const ::boost::type_erasure::detail::storage& data_arg)
+    {
+        _boost_type_erasure_adopt_guard guard(table_arg, data_arg);
+        _boost_type_erasure_block = new _boost_type_erasure_block_type(table_arg, data_arg);
+        guard.table = 0;
+    }
+
+    // Takes ownership of an object that was constructed
+    // in memory.space().
+    void _boost_type_erasure_init(const _boost_type_erasure_table_type& table_arg,
+        const _boost_type_erasure_allocation& memory,
+        const ::boost::type_erasure::detail::storage& data_arg)
+    {
+        if(memory.block != 0 && data_arg.data == static_cast<char*>(memory.block) +
+            ::boost::type_erasure::detail::intrusive_object_offset<_boost_type_erasure_block_type>::value)
+        {
+            _boost_type_erasure_block = ::new (memory.block) _boost_type_erasure_block_type(table_arg, data_arg);
+        } else {
+            _boost_type_erasure_adopt(table_arg, data_arg);
+        }
+    }
+
+    template<class... U>
+    void _boost_type_erasure_construct(const _boost_type_erasure_table_type& table_arg, U&&... u)
+    {
+        _boost_type_erasure_allocation memory;
+        ::boost::type_erasure::detail::storage data_arg =
+            ::boost::type_erasure::detail::construct_in(memory.space(), std::forward<U>(u)...);
+        _boost_type_erasure_init(table_arg, memory, data_arg);
+    }
+
+    // Creates a V from u... for the vtable table_arg.
+    template<class V, class... U>
+    void _boost_type_erasure_capture(const _boost_type_erasure_table_type& table_arg, U&&... u)
+    {
+        _boost_type_erasure_allocation memory;
+        ::boost::type_erasure::detail::storage data_arg =
+            ::boost::type_erasure::detail::construct_value<V>(memory.space(), std::forward<U>(u)...);
+        _boost_type_erasure_init(table_arg, memory, data_arg);
+    }
+
+    static _boost_type_erasure_block_type* _boost_type_erasure_empty_block()
+    {
+        BOOST_MPL_ASSERT((::boost::type_erasure::is_relaxed<Concept>));
+        static _boost_type_erasure_block_type result;
+        return &result;
+    }
+    static bool _boost_type_erasure_is_empty(_boost_type_erasure_block_type* block, ::boost::mpl::true_)
+    { return block == _boost_type_erasure_empty_block(); }
+    static bool _boost_type_erasure_is_empty(_boost_type_erasure_block_type*, ::boost::mpl::false_)
+    { return false; }
+
+    template<class U>
+    void _boost_type_erasure_convert(U&& other, ::boost::mpl::true_)
+    {
+        _boost_type_erasure_share(other);
+    }
+    template<class U>
+    void _boost_type_erasure_convert(U&& other, ::boost::mpl::false_)
+    {
+        _boost_type_erasure_construct(
+            _boost_type_erasure_table_type(
+                ::boost::type_erasure::detail::access::table(other),
+                typename ::boost::mpl::if_c< ::boost::is_same<T, ::boost::type_erasure::detail::safe_placeholder_t<U> >::value,
+#ifndef BOOST_TYPE_ERASURE_USE_MP11
+                    ::boost::type_erasure::detail::substitution_map< ::boost::mpl::map0<> >,
+#else
+                    ::boost::type_erasure::detail::make_identity_placeholder_map<Concept>,
+#endif
+                    ::boost::mpl::map1<
+                        ::boost::mpl::pair<
+                            T,
+                            ::boost::type_erasure::detail::safe_placeholder_t<U>
+                        >
+                    >
+                >::type()
+            ),
+            ::boost::type_erasure::detail::make(
+                false? other._boost_type_erasure_deduce_constructor(std::forward<U>(other)) : 0
+            ), std::forward<U>(other));
+    }
+    template<class Other>
+    void _boost_type_erasure_copy_from(Other& other, ::boost::mpl::true_)
+    {
+        _boost_type_erasure_share(other);
+    }
+    void _boost_type_erasure_copy_from(const any_constructor_impl& other, ::boost::mpl::false_)
+    {
+        _boost_type_erasure_construct(
+            other._boost_type_erasure_block->table,
+            ::boost::type_erasure::detail::make(
+                false? other._boost_type_erasure_deduce_constructor(
+                    static_cast<typename _boost_type_erasure_base::_boost_type_erasure_derived_type const&>(other)) : 0
+            ), other);
+    }
+    void _boost_type_erasure_copy_from(any_constructor_impl& other, ::boost::mpl::false_)
+    {
+        _boost_type_erasure_construct(
+            other._boost_type_erasure_block->table,
+            ::boost::type_erasure::detail::make(
+                false? other._boost_type_erasure_deduce_constructor(
+                    static_cast<typename _boost_type_erasure_base::_boost_type_erasure_derived_type &>(other)) : 0
+            ), other);
+    }
+
+    // A relaxed any may be left empty, so it can give
+    // away its block.
+    void _boost_type_erasure_move_from(any_constructor_impl& other, ::boost::mpl::true_)
+    {
+        _boost_type_erasure_block = other._boost_type_erasure_block;
+        other._boost_type_erasure_block = _boost_type_erasure_empty_block();
+    }
+    void _boost_type_erasure_move_assign(any_constructor_impl& other)
+    {
+        if(this == &other) {
+            return;
+        }
+        _boost_type_erasure_block_type* block = _boost_type_erasure_block;
+        _boost_type_erasure_move_from(other, ::boost::mpl::true_());
+        _boost_type_erasure_release_block(block);
+    }
+    void _boost_type_erasure_move_from(any_constructor_impl& other, ::boost::mpl::false_)
+    {
+        _boost_type_erasure_move_construct(other, _boost_type_erasure_shared());
+    }
+    void _boost_type_erasure_move_construct(any_constructor_impl& other, ::boost::mpl::true_)
+    {
+        _boost_type_erasure_share(other);
+    }
+    void _boost_type_erasure_move_construct(any_constructor_impl& other, ::boost::mpl::false_)
+    {
+        _boost_type_erasure_construct(
+            other._boost_type_erasure_block->table,
+            ::boost::type_erasure::detail::make(
+                false? other._boost_type_erasure_deduce_constructor(
+                    static_cast<typename _boost_type_erasure_base::_boost_type_erasure_derived_type &&>(other)) : 0
+            ), std::move(other));
+    }
+
+    void _boost_type_erasure_share(const any_constructor_impl& other)
+    {
+        _boost_type_erasure_block_type* block = other._boost_type_erasure_block;
+        if(!_boost_type_erasure_is_empty(block, ::boost::type_erasure::is_relaxed<Concept>())) {
+            block->count.fetch_add(1, ::boost::memory_order_relaxed);
+        }
+        _boost_type_erasure_block = block;
+    }
+    static void _boost_type_erasure_release_block(_boost_type_erasure_block_type* block)
+    {
+        if(_boost_type_erasure_is_empty(block, ::boost::type_erasure::is_relaxed<Concept>()) ||
+            !_boost_type_erasure_release(block, _boost_type_erasure_shared()))
+        {
+            return;
+        }
+        if(block->holds_object_inline()) {
+            // This frees the whole block.
+            block->table.template find<
+                ::boost::type_erasure::destructible<T>
+            >()(block->data, _boost_type_erasure_allocation::data_space(),
+                0, ::boost::type_erasure::detail::storage_space());
+        } else {
+            block->table.template find<
+                ::boost::type_erasure::destructible<T>
+            >()(block->data, ::boost::type_erasure::detail::storage_space(),
+                0, ::boost::type_erasure::detail::storage_space());
+            delete block;
+        }
+    }
+    // Returns true if the caller released the last reference.
+    static bool _boost_type_erasure_release(_boost_type_erasure_block_type* block, ::boost::mpl::true_)
+    {
+        return block->count.fetch_sub(1, ::boost::memory_order_acq_rel) == 1;
+    }
+    static bool _boost_type_erasure_release(_boost_type_erasure_block_type*, ::boost::mpl::false_)
+    {
+        return true;
+    }
+    // Gives this any a copy of its own before the object
+    // can be modified.
+    void _boost_type_erasure_unshare(::boost::mpl::true_)
+    {
+        _boost_type_erasure_block_type* block = _boost_type_erasure_block;
+        if(_boost_type_erasure_is_empty(block, ::boost::type_erasure::is_relaxed<Concept>()) ||
+            block->count.load(::boost::memory_order_acquire) == 1)
+        {
+            return;
+        }
+        const typename _boost_type_erasure_base::_boost_type_erasure_derived_type& self =
+            static_cast<const typename _boost_type_erasure_base::_boost_type_erasure_derived_type&>(*this);
+        _boost_type_erasure_construct(
+            block->table,
+            ::boost::type_erasure::detail::make(
+                false? this->_boost_type_erasure_deduce_constructor(self) : 0
+            ), self);
+        // The copies may have been destroyed in the meantime.
+        _boost_type_erasure_release_block(block);
+    }
+    void _boost_type_erasure_unshare(::boost::mpl::false_) {}
+
+    bool _boost_type_erasure_is_unique() const
+    { return _boost_type_erasure_is_unique(_boost_type_erasure_shared()); }
+    bool _boost_type_erasure_is_unique(::boost::mpl::true_) const
+    { return _boost_type_erasure_block->count.load(::boost::memory_order_acquire) == 1; }
+    bool _boost_type_erasure_is_unique(::boost::mpl::false_) const
+    { return true; }
+
+    void _boost_type_erasure_swap_impl(any_constructor_impl& other)
+    {
+        ::std::swap(_boost_type_erasure_block, other._boost_type_erasure_block);
+    }
+
+    const _boost_type_erasure_table_type& _boost_type_erasure_get_table() const
+    { return _boost_type_erasure_block->table; }
+    // Requires that the block is not shared.
+    void _boost_type_erasure_set_table(const _boost_type_erasure_table_type& table_arg)
+    { _boost_type_erasure_block->table = table_arg; }
+    ::boost::type_erasure::detail::storage& _boost_type_erasure_get_data()
+    {
+        _boost_type_erasure_unshare(_boost_type_erasure_shared());
+        return _boost_type_erasure_block->data;
+    }
+    const ::boost::type_erasure::detail::storage& _boost_type_erasure_get_data() const
+    { return _boost_type_erasure_block->data; }
+
+    _boost_type_erasure_block_type* _boost_type_erasure_block;
 };
 
 namespace detail {
@@ -817,6 +1503,30 @@ public:
 
 #endif
 
+#ifdef BOOST_TYPE_ERASURE_DOXYGEN
+    /**
+     * Constructs an @ref any to hold a copy of @c data,
+     * which is allocated with a copy of @c alloc.
+     *
+     * \param alloc The allocator to use.
+     * \param data The object to store in the @ref any.
+     *
+     * \pre @c Concept includes @ref with_allocator "with_allocator<Alloc>".
+     * \pre @c Alloc can be constructed from @c A.
+     * \pre @c U is a model of @c Concept.
+     * \pre @c U must be \CopyConstructible.
+     * \pre @c Concept must not refer to any non-deduced placeholder besides @c T.
+     *
+     * \throws Whatever @c alloc throws or whatever that the copy
+     *         constructor of @c U throws.
+     *
+     * \note This constructor never matches if @c data is
+     *       an @ref any, @ref binding, or @ref static_binding.
+     */
+    template<class A, class U>
+    any(std::allocator_arg_t, const A& alloc, U&& data);
+#endif
+
     // Handle array/function-to-pointer decay
     /** INTERNAL ONLY */
     template<class U>
@@ -856,6 +1566,31 @@ public:
       : table(other.table),
         data(::boost::type_erasure::call(constructible<T(const T&)>(), other))
     {}
+#ifdef BOOST_TYPE_ERASURE_DOXYGEN
+    /**
+     * Moves an @ref any.
+     *
+     * If @c Concept includes @ref relaxed, this takes over the
+     * object held by @c other without calling any constructor
+     * of the contained type, and leaves @c other empty.
+     * Otherwise, the contained type is move constructed (or
+     * copied if there is no move constructor in @c Concept).
+     *
+     * \param other The object to move from.
+     *
+     * \pre @c Concept must contain @ref constructible "constructible<T(T&&)>"
+     *      or @ref constructible "constructible<T(const T&)>".
+     *
+     * \throws Nothing if @c Concept includes @ref relaxed or
+     *         @ref copy_on_write, and the constructor is
+     *         declared @c noexcept.  Containers such as
+     *         @c std::vector then move their elements when
+     *         they grow, instead of copying them.  Otherwise
+     *         std::bad_alloc or whatever the move (or copy)
+     *         constructor of the contained type throws.
+     */
+    any(any&& other) noexcept(see below);
+#endif
     /**
      * Upcasts from an @ref any with stricter requirements to
      * an @ref any with weaker requirements.
@@ -1003,13 +1738,11 @@ public:
 #else
 #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
     any(any&& other)
-      : table(::boost::type_erasure::detail::access::table(other)),
-        data(::boost::type_erasure::call(
-            ::boost::type_erasure::detail::make(
-                false? this->_boost_type_erasure_deduce_constructor(std::move(other)) : 0
-            ), std::move(other))
-        )
-    {}
+        BOOST_NOEXCEPT_IF(::boost::type_erasure::detail::has_nothrow_move<Concept>::value)
+      : table(::boost::type_erasure::detail::access::table(other))
+    {
+        _boost_type_erasure_move_from(other, ::boost::type_erasure::is_relaxed<Concept>());
+    }
     any(any& other)
       : table(::boost::type_erasure::detail::access::table(other)),
         data(::boost::type_erasure::call(
@@ -1564,6 +2297,10 @@ public:
      * \note If @c U is an @ref any, then this can decide dynamically
      *       whether to use construction based on the type stored in other.
      *
+     * \note When falling back on construction from a value of the
+     *       type that is already stored, the new object reuses the
+     *       storage of the old one, as with @ref emplace.
+     *
      * \throws Whatever the assignment operator of the contained
      *         type throws.  When falling back on construction,
      *         throws @c std::bad_alloc or whatever the move (or copy)
@@ -1581,6 +2318,36 @@ public:
     }
 #endif
 
+#if defined(BOOST_TYPE_ERASURE_SFINAE_FRIENDLY_CONSTRUCTORS) || defined(BOOST_TYPE_ERASURE_DOXYGEN)
+    /**
+     * Replaces the contained object with a @c U created
+     * from @c arg...  If the @ref any already holds a @c U
+     * that no other @ref any shares, the new object takes
+     * its place in the same storage, without allocating.
+     *
+     * \return A reference to the new object.
+     *
+     * \pre @c Concept includes @ref relaxed.
+     *
+     * \throws std::bad_alloc or whatever the constructor of
+     *         @c U throws.  The @ref any is unchanged if
+     *         an exception is thrown.
+     *
+     * \note The storage is only reused when @c U can be
+     *       constructed from @c arg... or moved without
+     *       throwing.  Otherwise, the new object is created
+     *       separately and the old one is destroyed.
+     */
+    template<class U, class... A>
+    U& emplace(A&&... arg)
+    {
+        BOOST_MPL_ASSERT((::boost::type_erasure::is_relaxed<Concept>));
+        return *_boost_type_erasure_emplace<U>(
+            ::boost::type_erasure::detail::can_reconstruct<U, A...>(),
+            std::forward<A>(arg)...);
+    }
+#endif
+
 #ifndef BOOST_TYPE_ERASURE_SFINAE_FRIENDLY_CONSTRUCTORS
     /**
      * \pre @c Concept includes @ref destructible "destructible<T>".
@@ -1589,7 +2356,9 @@ public:
     {
         ::boost::type_erasure::detail::access::table(*this).template find<
             ::boost::type_erasure::destructible<T>
-        >()(::boost::type_erasure::detail::access::data(*this));
+        >()(::boost::type_erasure::detail::access::data(*this),
+            ::boost::type_erasure::detail::storage_space(),
+            0, ::boost::type_erasure::detail::storage_space());
     }
 #endif
 
@@ -1616,11 +2385,115 @@ private:
         ::std::swap(data, other.data);
         ::std::swap(table, other.table);
     }
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    /** INTERNAL ONLY */
+    void _boost_type_erasure_move_from(any& other, ::boost::mpl::true_)
+    {
+        data = other.data;
+        other.table = table_type();
+        other.data.data = 0;
+    }
+    /** INTERNAL ONLY */
+    void _boost_type_erasure_move_from(any& other, ::boost::mpl::false_)
+    {
+        data = ::boost::type_erasure::call(
+            ::boost::type_erasure::detail::make(
+                false? this->_boost_type_erasure_deduce_constructor(std::move(other)) : 0
+            ), std::move(other));
+    }
+    /** INTERNAL ONLY */
+    template<class Other>
+    void _boost_type_erasure_replace(Other&& other)
+    {
+        any temp(std::forward<Other>(other));
+        _boost_type_erasure_swap(temp);
+    }
+#endif
 #else
     void _boost_type_erasure_swap(any& other)
     {
-        ::std::swap(this->_boost_type_erasure_data, other._boost_type_erasure_data);
-        ::std::swap(this->_boost_type_erasure_table, other._boost_type_erasure_table);
+        this->_boost_type_erasure_swap_impl(other);
+    }
+    template<class U, class... A>
+    U* _boost_type_erasure_emplace(::boost::mpl::true_, A&&... arg)
+    {
+        const ::boost::type_erasure::detail::object_traits& traits =
+            ::boost::type_erasure::detail::access::table(*this).template find_traits<T>();
+        // The size check is cheap and also rules out tables
+        // of unknown type, whose traits are all zero.
+        if(this->_boost_type_erasure_is_unique() && traits.size == sizeof(U) &&
+            ::boost::type_erasure::detail::same_type(traits.type,
+                ::boost::type_erasure::detail::type_token_of<U>::value))
+        {
+            return ::boost::type_erasure::detail::reconstruct<U>(
+                ::boost::type_erasure::detail::access::data(*this).data,
+                std::forward<A>(arg)...);
+        }
+        return _boost_type_erasure_emplace<U>(::boost::mpl::false_(), std::forward<A>(arg)...);
+    }
+    template<class U, class... A>
+    U* _boost_type_erasure_emplace(::boost::mpl::false_, A&&... arg)
+    {
+        any temp(::boost::type_erasure::in_place_type_t<U>(), std::forward<A>(arg)...);
+        _boost_type_erasure_swap(temp);
+        return static_cast<U*>(::boost::type_erasure::detail::access::data(*this).data);
+    }
+    template<class Other>
+    void _boost_type_erasure_assign_value(Other&& other, ::boost::mpl::true_)
+    {
+        this->template emplace< ::boost::decay_t<Other> >(std::forward<Other>(other));
+    }
+    template<class Other>
+    void _boost_type_erasure_assign_value(Other&& other, ::boost::mpl::false_)
+    {
+        any temp(std::forward<Other>(other));
+        _boost_type_erasure_swap(temp);
+    }
+    template<class Other>
+    void _boost_type_erasure_replace(Other&& other)
+    {
+        any temp(std::forward<Other>(other));
+        _boost_type_erasure_swap(temp);
+    }
+    // An rvalue of the same type gives up its object, so
+    // that the result of a call can be assigned without
+    // going through a temporary.
+    void _boost_type_erasure_replace(any&& other)
+    {
+        this->_boost_type_erasure_move_assign(other);
+    }
+    // Assigns the result of Impl::apply_in<F, Guess>.  If the
+    // any holds an object of the same type as the result, which
+    // no other any shares, the result takes its place.
+    template<class Impl, class F, class Guess, class... U>
+    void _boost_type_erasure_assign_result(
+        ::boost::type_erasure::detail::result_in_place<Impl, F, Guess> tag,
+        const table_type& table_arg, U&&... u)
+    {
+        const ::boost::type_erasure::detail::object_traits& current =
+            ::boost::type_erasure::detail::access::table(*this).template find_traits<T>();
+        const ::boost::type_erasure::detail::object_traits& next =
+            table_arg.template find_traits<T>();
+        if(this->_boost_type_erasure_is_unique() && current.size != 0 &&
+            current.size == next.size &&
+            ::boost::type_erasure::detail::same_type(current.type, next.type))
+        {
+            ::boost::type_erasure::detail::storage_space space;
+            space.replace = ::boost::type_erasure::detail::access::data(*this).data;
+            ::boost::type_erasure::detail::storage data_arg =
+                Impl::template apply_in<F, Guess>(space, &table_arg, std::forward<U>(u)...);
+            if(data_arg.data == space.replace) {
+                this->_boost_type_erasure_set_table(table_arg);
+                return;
+            }
+            // The type cannot be replaced without risking an
+            // exception, so the result was put on the heap.
+            any temp(data_arg, table_arg);
+            this->_boost_type_erasure_move_assign(temp);
+            return;
+        }
+        any temp(tag, table_arg, std::forward<U>(u)...);
+        this->_boost_type_erasure_move_assign(temp);
     }
 #endif
 #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
@@ -1671,8 +2544,17 @@ private:
         const void*,
         ::boost::mpl::true_)
     {
+#ifdef BOOST_TYPE_ERASURE_SFINAE_FRIENDLY_CONSTRUCTORS
+        _boost_type_erasure_assign_value(std::forward<Other>(other),
+            ::boost::mpl::bool_<
+                !::boost::type_erasure::detail::is_binding_arg<Other>::value &&
+                !::boost::type_erasure::detail::is_static_binding_arg<Other>::value &&
+                !::boost::type_erasure::detail::is_in_place_arg<Other>::value
+            >());
+#else
         any temp(std::forward<Other>(other));
         _boost_type_erasure_swap(temp);
+#endif
     }
 #else
     /** INTERNAL ONLY */
@@ -1808,8 +2690,7 @@ private:
         const constructible<Sig>*,
         ::boost::mpl::true_)
     {
-        any temp(std::forward<Other>(other));
-        _boost_type_erasure_swap(temp);
+        _boost_type_erasure_replace(std::forward<Other>(other));
     }
     /** INTERNAL ONLY */
     template<class Other, class U, class Sig>
@@ -2006,15 +2887,23 @@ public:
      *
      * \throws Nothing.
      */
+#ifndef BOOST_NO_CXX11_DEFAULTED_FUNCTIONS
+    any(const any& other) = default;
+#else
     any(const any& other)
       : data(other.data),
         table(other.table)
     {}
+#endif
 #ifndef BOOST_TYPE_ERASURE_DOXYGEN
+#ifndef BOOST_NO_CXX11_DEFAULTED_FUNCTIONS
+    any(any& other) = default;
+#else
     any(any& other)
       : data(other.data),
         table(other.table)
     {}
+#endif
 #endif
     /**
      * Constructs an @ref any from another @ref any.
@@ -2466,10 +3355,14 @@ public:
      *
      * \throws Nothing.
      */
+#ifndef BOOST_NO_CXX11_DEFAULTED_FUNCTIONS
+    any(const any& other) = default;
+#else
     any(const any& other)
       : data(other.data),
         table(other.table)
     {}
+#endif
     /**
      * Constructs an @ref any from another @ref any.
      *
@@ -2704,6 +3597,10 @@ public:
      * \throws Nothing.
      */
 #ifndef BOOST_TYPE_ERASURE_DOXYGEN
+#ifndef BOOST_NO_CXX11_DEFAULTED_FUNCTIONS
+    any(any&& other) = default;
+    any(const any& other) = default;
+#else
     any(any&& other)
       : data(other.data),
         table(std::move(other.table))
@@ -2712,6 +3609,7 @@ public:
       : data(other.data),
         table(other.table)
     {}
+#endif
 #endif
     /**
      * Constructs an @ref any from another @ref any.
@@ -14,6 +14,7 @@
 #include <stdexcept>
 #include <boost/throw_exception.hpp>
 #include <boost/type_traits/add_const.hpp>
+#include <boost/type_traits/is_const.hpp>
 #include <boost/type_traits/is_pointer.hpp>
 #include <boost/type_traits/remove_cv.hpp>
 #include <boost/type_traits/remove_reference.hpp>
@@ -21,10 +22,12 @@
 #include <boost/type_traits/is_void.hpp>
 #include <boost/mpl/assert.hpp>
 #include <boost/mpl/bool.hpp>
+#include <boost/mpl/if.hpp>
 #include <boost/type_erasure/any.hpp>
 #include <boost/type_erasure/builtin.hpp>
 #include <boost/type_erasure/exception.hpp>
 #include <boost/type_erasure/detail/access.hpp>
+#include <boost/type_erasure/detail/type_token.hpp>
 
 namespace boost {
 namespace type_erasure {
@@ -67,6 +70,19 @@ const void* get_pointer(const ::boost::type_erasure::any<Concept, const T&>& arg
     return ::boost::type_erasure::detail::access::data(arg).data;
 }
 
+// Only a cast that can modify the object needs non-const
+// access to the any.  With copy_on_write, non-const access
+// copies the object if it is shared.  U is the type of the
+// object as seen through the result of the cast.
+template<class U, class Concept, class Tag>
+typename ::boost::mpl::if_< ::boost::is_const<U>,
+    const any<Concept, Tag>&,
+    any<Concept, Tag>&
+>::type access_for_cast(any<Concept, Tag>& arg)
+{
+    return arg;
+}
+
 template<class T, class Concept, class Tag>
 bool check_any_cast(const any<Concept, Tag>&, ::boost::mpl::true_)
 {
@@ -79,8 +95,8 @@ bool check_any_cast(const any<Concept, Tag>& arg, ::boost::mpl::false_)
     typedef typename ::boost::remove_cv<
         typename ::boost::remove_reference<Tag>::type
     >::type tag_type;
-    return ::boost::type_erasure::detail::access::table(arg)
-        .template find<typeid_<tag_type> >()() == typeid(T);
+    return ::boost::type_erasure::detail::is_bound_to<tag_type, T>(
+        ::boost::type_erasure::detail::access::table(arg));
 }
 
 template<class T, class Concept, class Tag>
@@ -123,7 +139,12 @@ T any_cast(any<Concept, Tag>& arg)
             typename ::boost::remove_reference<
                 typename ::boost::add_const<T>::type
             >::type*
-        >(::boost::type_erasure::detail::get_pointer(arg));
+        >(::boost::type_erasure::detail::get_pointer(
+            ::boost::type_erasure::detail::access_for_cast<
+                typename ::boost::remove_reference<
+                    typename ::boost::add_const<T>::type
+                >::type
+            >(arg)));
     } else {
         BOOST_THROW_EXCEPTION(::boost::type_erasure::bad_any_cast());
     }
@@ -153,7 +174,9 @@ T any_cast(any<Concept, Tag>* arg)
         typename ::boost::remove_pointer<T>::type>(*arg)) {
         return static_cast<
             typename ::boost::remove_pointer<T>::type*>(
-                ::boost::type_erasure::detail::get_pointer(*arg));
+                ::boost::type_erasure::detail::get_pointer(
+                    ::boost::type_erasure::detail::access_for_cast<
+                        typename ::boost::remove_pointer<T>::type>(*arg)));
     } else {
         return 0;
     }
@@ -0,0 +1,348 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#ifndef BOOST_TYPE_ERASURE_ANY_COLLECTION_HPP_INCLUDED
+#define BOOST_TYPE_ERASURE_ANY_COLLECTION_HPP_INCLUDED
+
+#include <cstddef>
+#include <vector>
+#include <boost/config.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/mpl/map.hpp>
+#include <boost/mpl/pair.hpp>
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/binding.hpp>
+#include <boost/type_erasure/static_binding.hpp>
+#include <boost/type_erasure/placeholder.hpp>
+#include <boost/type_erasure/detail/instantiate.hpp>
+#include <boost/type_erasure/detail/storage.hpp>
+
+namespace boost {
+namespace type_erasure {
+
+namespace detail {
+
+// The objects of one type, stored contiguously.  The
+// base records where they are, so that iterating over them
+// needs no virtual calls.
+template<class Concept>
+class collection_segment
+{
+public:
+    collection_segment(const ::boost::type_erasure::binding<Concept>& table_arg, std::size_t stride_arg)
+      : table(table_arg),
+        data(0),
+        size(0),
+        stride(stride_arg)
+    {}
+    virtual ~collection_segment() {}
+    void* at(std::size_t i) const
+    {
+        return static_cast<char*>(data) + i * stride;
+    }
+    ::boost::type_erasure::binding<Concept> table;
+    void* data;
+    std::size_t size;
+    std::size_t stride;
+};
+
+template<class Concept, class U>
+class typed_collection_segment :
+    public ::boost::type_erasure::detail::collection_segment<Concept>
+{
+public:
+    explicit typed_collection_segment(const ::boost::type_erasure::binding<Concept>& table_arg)
+      : ::boost::type_erasure::detail::collection_segment<Concept>(table_arg, sizeof(U))
+    {}
+    U& push_back(const U& arg)
+    {
+        elements.push_back(arg);
+        return update();
+    }
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    template<class... A>
+    U& emplace_back(A&&... arg)
+    {
+        elements.emplace_back(std::forward<A>(arg)...);
+        return update();
+    }
+#endif
+private:
+    U& update()
+    {
+        this->data = &elements[0];
+        this->size = elements.size();
+        return elements.back();
+    }
+    std::vector<U> elements;
+};
+
+template<class Reference, class Segment>
+class collection_iterator :
+    public ::boost::iterator_facade<
+        collection_iterator<Reference, Segment>,
+        Reference,
+        ::boost::forward_traversal_tag,
+        Reference
+    >
+{
+public:
+    collection_iterator() : pos(0), end_pos(0), index(0) {}
+    collection_iterator(Segment* const* pos_arg, Segment* const* end_arg)
+      : pos(pos_arg),
+        end_pos(end_arg),
+        index(0)
+    {
+        skip_empty();
+    }
+private:
+    friend class ::boost::iterator_core_access;
+    Reference dereference() const
+    {
+        ::boost::type_erasure::detail::storage data;
+        data.data = (*pos)->at(index);
+        return Reference(data, (*pos)->table);
+    }
+    void increment()
+    {
+        ++index;
+        skip_empty();
+    }
+    bool equal(const collection_iterator& other) const
+    {
+        return pos == other.pos && index == other.index;
+    }
+    void skip_empty()
+    {
+        while(pos != end_pos && index == (*pos)->size) {
+            ++pos;
+            index = 0;
+        }
+    }
+    Segment* const* pos;
+    Segment* const* end_pos;
+    std::size_t index;
+};
+
+}
+
+/**
+ * A container of objects of any type that models
+ * @c Concept.  The objects of each type are stored
+ * contiguously in their own segment instead of each
+ * being allocated separately, as an @ref any does.
+ * Iteration visits the segments in the order in which
+ * their types were first inserted, and the objects of
+ * each segment in the order in which they were inserted.
+ *
+ * The elements are accessed through references:
+ * @c reference is <code>any<Concept, T&></code> and
+ * @c const_reference is <code>any<Concept, const T&></code>.
+ * All the references to the elements of a segment share
+ * its @ref binding, so calls through them go to the same
+ * functions many times in a row.
+ *
+ * Inserting an object may move the other objects of the
+ * same type, which invalidates iterators and references
+ * to them.
+ *
+ * \tparam Concept The concept that the elements model.
+ * \tparam T The placeholder that the elements bind to.
+ *
+ * \pre @c Concept must not refer to any non-deduced
+ *      placeholder besides @c T.
+ */
+template<class Concept, class T = _self>
+class any_collection
+{
+    typedef ::boost::type_erasure::detail::collection_segment<Concept> segment_type;
+public:
+    typedef ::boost::type_erasure::any<Concept, T&> reference;
+    typedef ::boost::type_erasure::any<Concept, const T&> const_reference;
+    /** A forward iterator whose @c reference is @c reference. */
+#ifdef BOOST_TYPE_ERASURE_DOXYGEN
+    typedef unspecified iterator;
+#else
+    typedef ::boost::type_erasure::detail::collection_iterator<
+        reference, segment_type> iterator;
+#endif
+    /** A forward iterator whose @c reference is @c const_reference. */
+#ifdef BOOST_TYPE_ERASURE_DOXYGEN
+    typedef unspecified const_iterator;
+#else
+    typedef ::boost::type_erasure::detail::collection_iterator<
+        const_reference, const segment_type> const_iterator;
+#endif
+    typedef std::size_t size_type;
+
+    /**
+     * Constructs an empty collection.
+     *
+     * \throws Nothing.
+     */
+    any_collection() {}
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    /**
+     * Takes the elements of @c other, leaving it empty.
+     *
+     * \throws Nothing.
+     */
+    any_collection(any_collection&& other)
+    {
+        segments.swap(other.segments);
+    }
+    /**
+     * Takes the elements of @c other, leaving it empty.
+     *
+     * \throws Nothing.
+     */
+    any_collection& operator=(any_collection&& other)
+    {
+        clear();
+        segments.swap(other.segments);
+        return *this;
+    }
+#endif
+    ~any_collection() { clear(); }
+
+    /**
+     * Copies @c arg to the end of the segment for @c U.
+     *
+     * \return A reference to the new element.
+     *
+     * \pre @c U is a model of @c Concept.
+     */
+    template<class U>
+    reference insert(const U& arg)
+    {
+        return reference(segment<U>().push_back(arg));
+    }
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    /**
+     * Constructs a @c U from @c arg at the end of the
+     * segment for @c U.
+     *
+     * \return A reference to the new element.
+     *
+     * \pre @c U is a model of @c Concept.
+     */
+    template<class U, class... A>
+    reference emplace(A&&... arg)
+    {
+        return reference(segment<U>().emplace_back(std::forward<A>(arg)...));
+    }
+#endif
+
+    /**
+     * Calls @c f with a @c reference to each element.
+     * This is faster than using iterators.
+     *
+     * \return @c f
+     */
+    template<class F>
+    F for_each(F f)
+    {
+        return for_each_impl<reference>(f);
+    }
+    /**
+     * \overload
+     */
+    template<class F>
+    F for_each(F f) const
+    {
+        return for_each_impl<const_reference>(f);
+    }
+
+    iterator begin()
+    { return iterator(first_segment(), first_segment() + segments.size()); }
+    iterator end()
+    { return iterator(first_segment() + segments.size(), first_segment() + segments.size()); }
+    const_iterator begin() const
+    { return const_iterator(first_segment(), first_segment() + segments.size()); }
+    const_iterator end() const
+    { return const_iterator(first_segment() + segments.size(), first_segment() + segments.size()); }
+
+    /** \return The number of elements. */
+    size_type size() const
+    {
+        size_type result = 0;
+        for(std::size_t i = 0; i < segments.size(); ++i) {
+            result += segments[i]->size;
+        }
+        return result;
+    }
+    /** \return true iff there are no elements. */
+    bool empty() const { return size() == 0; }
+    /**
+     * Destroys all the elements.
+     *
+     * \throws Nothing.
+     */
+    void clear()
+    {
+        for(std::size_t i = 0; i < segments.size(); ++i) {
+            delete segments[i];
+        }
+        segments.clear();
+    }
+private:
+    any_collection(const any_collection&);
+    any_collection& operator=(const any_collection&);
+
+    segment_type* const* first_segment() const
+    {
+        return segments.empty()? 0 : &segments[0];
+    }
+
+    template<class R, class F>
+    F for_each_impl(F& f) const
+    {
+        for(std::size_t i = 0; i < segments.size(); ++i) {
+            const segment_type& seg = *segments[i];
+            ::boost::type_erasure::detail::storage data;
+            for(std::size_t j = 0; j < seg.size; ++j) {
+                data.data = seg.at(j);
+                f(R(data, seg.table));
+            }
+        }
+        return f;
+    }
+
+    // Finds the segment by the address of its static table,
+    // which is different for every U.
+    template<class U>
+    ::boost::type_erasure::detail::typed_collection_segment<Concept, U>& segment()
+    {
+        typedef ::boost::type_erasure::detail::typed_collection_segment<Concept, U> typed_segment;
+        ::boost::type_erasure::binding<Concept> table((
+            BOOST_TYPE_ERASURE_INSTANTIATE1(Concept, T, U),
+            ::boost::type_erasure::make_binding<
+                ::boost::mpl::map1< ::boost::mpl::pair<T, U> >
+            >()
+        ));
+        const void* key = table._boost_type_erasure_table_address();
+        for(std::size_t i = 0; i < segments.size(); ++i) {
+            if(segments[i]->table._boost_type_erasure_table_address() == key) {
+                return static_cast<typed_segment&>(*segments[i]);
+            }
+        }
+        segments.reserve(segments.size() + 1);
+        typed_segment* result = new typed_segment(table);
+        segments.push_back(result);
+        return *result;
+    }
+
+    std::vector<segment_type*> segments;
+};
+
+}
+}
+
+#endif
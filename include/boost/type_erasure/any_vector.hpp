@@ -0,0 +1,360 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#ifndef BOOST_TYPE_ERASURE_ANY_VECTOR_HPP_INCLUDED
+#define BOOST_TYPE_ERASURE_ANY_VECTOR_HPP_INCLUDED
+
+#include <cstddef>
+#include <vector>
+#include <boost/config.hpp>
+#include <boost/assert.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/mpl/map.hpp>
+#include <boost/mpl/pair.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/binding.hpp>
+#include <boost/type_erasure/builtin.hpp>
+#include <boost/type_erasure/static_binding.hpp>
+#include <boost/type_erasure/placeholder.hpp>
+#include <boost/type_erasure/detail/instantiate.hpp>
+#include <boost/type_erasure/detail/storage.hpp>
+
+#if defined(BOOST_MSVC) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#endif
+
+namespace boost {
+namespace type_erasure {
+
+namespace detail {
+
+// Asks the CPU to start loading the cache line at p.
+inline void prefetch(const void* p)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p);
+#elif defined(BOOST_MSVC) && (defined(_M_IX86) || defined(_M_X64))
+    _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#else
+    (void)p;
+#endif
+}
+
+template<class Reference, class Concept>
+class any_vector_iterator :
+    public ::boost::iterator_facade<
+        any_vector_iterator<Reference, Concept>,
+        Reference,
+        ::boost::random_access_traversal_tag,
+        Reference
+    >
+{
+public:
+    any_vector_iterator() : table(0), data(0) {}
+    any_vector_iterator(
+        const ::boost::type_erasure::binding<Concept>* table_arg,
+        void* const* data_arg)
+      : table(table_arg),
+        data(data_arg)
+    {}
+    template<class R>
+    any_vector_iterator(const any_vector_iterator<R, Concept>& other,
+        typename ::boost::enable_if< ::boost::is_convertible<R, Reference> >::type* = 0)
+      : table(other.table),
+        data(other.data)
+    {}
+private:
+    friend class ::boost::iterator_core_access;
+    template<class R, class C>
+    friend class any_vector_iterator;
+    Reference dereference() const
+    {
+        ::boost::type_erasure::detail::storage object;
+        object.data = *data;
+        return Reference(object, *table);
+    }
+    void increment() { ++table; ++data; }
+    void decrement() { --table; --data; }
+    void advance(std::ptrdiff_t n) { table += n; data += n; }
+    std::ptrdiff_t distance_to(const any_vector_iterator& other) const
+    {
+        return other.data - data;
+    }
+    bool equal(const any_vector_iterator& other) const
+    {
+        return data == other.data;
+    }
+    const ::boost::type_erasure::binding<Concept>* table;
+    void* const* data;
+};
+
+}
+
+/**
+ * A sequence of objects of any type that models
+ * @c Concept, in the order in which they were added.
+ * Unlike <code>std::vector<any<Concept, T> ></code>,
+ * the bindings and the addresses of the objects are
+ * kept in two separate arrays.  A loop that only looks at
+ * the bindings, for instance to select the objects of
+ * one type, reads only the first array.
+ *
+ * The elements are accessed through references:
+ * @c reference is <code>any<Concept, T&></code> and
+ * @c const_reference is <code>any<Concept, const T&></code>.
+ * Adding elements does not move the objects themselves,
+ * but invalidates iterators.
+ *
+ * \tparam Concept The concept that the elements model.
+ * \tparam T The placeholder that the elements bind to.
+ *
+ * \pre @c Concept includes @ref destructible "destructible<T>".
+ * \pre @c Concept must not refer to any non-deduced
+ *      placeholder besides @c T.
+ */
+template<class Concept, class T = _self>
+class any_vector
+{
+public:
+    typedef ::boost::type_erasure::any<Concept, T&> reference;
+    typedef ::boost::type_erasure::any<Concept, const T&> const_reference;
+    /** A random access iterator whose @c reference is @c reference. */
+#ifdef BOOST_TYPE_ERASURE_DOXYGEN
+    typedef unspecified iterator;
+#else
+    typedef ::boost::type_erasure::detail::any_vector_iterator<
+        reference, Concept> iterator;
+#endif
+    /** A random access iterator whose @c reference is @c const_reference. */
+#ifdef BOOST_TYPE_ERASURE_DOXYGEN
+    typedef unspecified const_iterator;
+#else
+    typedef ::boost::type_erasure::detail::any_vector_iterator<
+        const_reference, Concept> const_iterator;
+#endif
+    typedef std::size_t size_type;
+
+    /**
+     * Constructs an empty vector.
+     *
+     * \throws Nothing.
+     */
+    any_vector() {}
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    /**
+     * Takes the elements of @c other, leaving it empty.
+     *
+     * \throws Nothing.
+     */
+    any_vector(any_vector&& other)
+    {
+        swap(other);
+    }
+    /**
+     * Takes the elements of @c other, leaving it empty.
+     *
+     * \throws Nothing.
+     */
+    any_vector& operator=(any_vector&& other)
+    {
+        clear();
+        swap(other);
+        return *this;
+    }
+#endif
+    ~any_vector() { clear(); }
+
+    /**
+     * Adds a copy of @c arg at the end.
+     *
+     * \pre @c U is a model of @c Concept.
+     */
+    template<class U>
+    void push_back(const U& arg)
+    {
+        reserve_one();
+        ::boost::type_erasure::detail::storage object(arg);
+        tables.push_back(make_table<U>());
+        data.push_back(object.data);
+    }
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    /**
+     * Adds a @c U constructed from @c arg at the end.
+     *
+     * \pre @c U is a model of @c Concept.
+     */
+    template<class U, class... A>
+    void emplace_back(A&&... arg)
+    {
+        reserve_one();
+        void* result = new U(std::forward<A>(arg)...);
+        tables.push_back(make_table<U>());
+        data.push_back(result);
+    }
+#endif
+    /**
+     * Destroys the last element.
+     *
+     * \pre The vector is not empty.
+     */
+    void pop_back()
+    {
+        BOOST_ASSERT(!empty());
+        destroy(size() - 1);
+        tables.pop_back();
+        data.pop_back();
+    }
+    /**
+     * Destroys all the elements.
+     *
+     * \throws Nothing.
+     */
+    void clear()
+    {
+        for(size_type i = 0; i < size(); ++i) {
+            destroy(i);
+        }
+        tables.clear();
+        data.clear();
+    }
+    void reserve(size_type n)
+    {
+        tables.reserve(n);
+        data.reserve(n);
+    }
+
+    /** \pre <code>i < size()</code> */
+    reference operator[](size_type i)
+    {
+        BOOST_ASSERT(i < size());
+        return reference(make_storage(data[i]), tables[i]);
+    }
+    /** \pre <code>i < size()</code> */
+    const_reference operator[](size_type i) const
+    {
+        BOOST_ASSERT(i < size());
+        return const_reference(make_storage(data[i]), tables[i]);
+    }
+
+    /**
+     * Calls @c f with a @c reference to each element, in
+     * order.  While it does so, it asks the CPU to load
+     * the objects that are a few elements ahead.
+     *
+     * \return @c f
+     */
+    template<class F>
+    F for_each(F f)
+    {
+        return for_each_impl<reference>(f);
+    }
+    /**
+     * \overload
+     */
+    template<class F>
+    F for_each(F f) const
+    {
+        return for_each_impl<const_reference>(f);
+    }
+
+    iterator begin() { return iterator(first_table(), first_data()); }
+    iterator end() { return iterator(first_table() + size(), first_data() + size()); }
+    const_iterator begin() const { return const_iterator(first_table(), first_data()); }
+    const_iterator end() const { return const_iterator(first_table() + size(), first_data() + size()); }
+
+    /** \return The number of elements. */
+    size_type size() const { return data.size(); }
+    /** \return true iff there are no elements. */
+    bool empty() const { return data.empty(); }
+    /**
+     * Exchanges the elements of two vectors.
+     *
+     * \throws Nothing.
+     */
+    void swap(any_vector& other)
+    {
+        tables.swap(other.tables);
+        data.swap(other.data);
+    }
+private:
+    any_vector(const any_vector&);
+    any_vector& operator=(const any_vector&);
+
+    // How many elements ahead for_each prefetches.
+    BOOST_STATIC_CONSTANT(size_type, prefetch_distance = 8);
+
+    static ::boost::type_erasure::detail::storage make_storage(void* address)
+    {
+        ::boost::type_erasure::detail::storage result;
+        result.data = address;
+        return result;
+    }
+
+    template<class U>
+    static ::boost::type_erasure::binding<Concept> make_table()
+    {
+        return ::boost::type_erasure::binding<Concept>((
+            BOOST_TYPE_ERASURE_INSTANTIATE1(Concept, T, U),
+            ::boost::type_erasure::make_binding<
+                ::boost::mpl::map1< ::boost::mpl::pair<T, U> >
+            >()
+        ));
+    }
+
+    // Makes room for one element in both arrays, so that
+    // adding it cannot fail half way.
+    void reserve_one()
+    {
+        if(data.size() == data.capacity() || tables.size() == tables.capacity()) {
+            reserve(size() < 8? 16 : size() * 2);
+        }
+    }
+
+    void destroy(size_type i)
+    {
+        ::boost::type_erasure::detail::storage object = make_storage(data[i]);
+        tables[i].template find< ::boost::type_erasure::destructible<T> >()(
+            object,
+            ::boost::type_erasure::detail::storage_space(),
+            0, ::boost::type_erasure::detail::storage_space());
+    }
+
+    template<class R, class F>
+    F for_each_impl(F& f) const
+    {
+        const size_type n = size();
+        for(size_type i = 0; i < n; ++i) {
+            if(i + prefetch_distance < n) {
+                ::boost::type_erasure::detail::prefetch(data[i + prefetch_distance]);
+            }
+            f(R(make_storage(data[i]), tables[i]));
+        }
+        return f;
+    }
+
+    const ::boost::type_erasure::binding<Concept>* first_table() const
+    {
+        return tables.empty()? 0 : &tables[0];
+    }
+    void* const* first_data() const
+    {
+        return data.empty()? 0 : &data[0];
+    }
+
+    std::vector< ::boost::type_erasure::binding<Concept> > tables;
+    std::vector<void*> data;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,196 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#ifndef BOOST_TYPE_ERASURE_BATCHED_HPP_INCLUDED
+#define BOOST_TYPE_ERASURE_BATCHED_HPP_INCLUDED
+
+#include <cstddef>
+#include <boost/utility/enable_if.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/mpl/map.hpp>
+#include <boost/mpl/pair.hpp>
+#include <boost/type_traits/is_const.hpp>
+#include <boost/type_traits/is_reference.hpp>
+#include <boost/type_traits/remove_const.hpp>
+#include <boost/type_traits/remove_reference.hpp>
+#include <boost/type_erasure/call.hpp>
+#include <boost/type_erasure/concept_interface.hpp>
+#include <boost/type_erasure/placeholder.hpp>
+#include <boost/type_erasure/detail/const.hpp>
+#include <boost/type_erasure/detail/get_signature.hpp>
+#include <boost/type_erasure/detail/rebind_placeholders.hpp>
+
+namespace boost {
+namespace type_erasure {
+
+namespace detail {
+
+template<class Sig>
+struct batch_signature;
+
+// Arguments taken by reference are passed as elements of
+// the array, so a non-const reference lets the operation
+// modify them.  Arguments taken by value are only read.
+template<class R, class P, class A>
+struct batch_signature<R(P&, A)>
+{
+    typedef P placeholder;
+    typedef typename ::boost::remove_reference<A>::type value_type;
+    typedef typename ::boost::mpl::if_< ::boost::is_reference<A>,
+        value_type,
+        const value_type
+    >::type* pointer;
+};
+
+template<class Op>
+struct batch_traits :
+    ::boost::type_erasure::detail::batch_signature<
+        typename ::boost::type_erasure::detail::get_signature<Op>::type
+    >
+{};
+
+}
+
+/**
+ * The @ref batched concept calls the primitive concept
+ * @c Op once for each element of an array with one indirect
+ * call, instead of one per element.  The loop runs on the
+ * contained type, so the compiler can inline @c Op into it
+ * and vectorize it.  No change to the contained type is
+ * needed.
+ *
+ * @c Op must take the placeholder by reference and exactly
+ * one other argument, which is not a placeholder, such as
+ * <code>callable<void(const int&)></code> or a concept
+ * defined by @ref BOOST_TYPE_ERASURE_MEMBER.  If the argument
+ * is a non-const reference, the array is not const, and
+ * @c Op may modify its elements.  The results of @c Op,
+ * if any, are discarded.  @c T is the placeholder that
+ * @c Op is called on and should be left at its default.
+ *
+ * Example:
+ *
+ * @code
+ * BOOST_TYPE_ERASURE_MEMBER(has_write, write)
+ * typedef any<mpl::vector<
+ *     copy_constructible<>,
+ *     has_write<void(const record&)>,
+ *     batched<has_write<void(const record&)> >
+ * > > sink;
+ * sink s = ...;
+ * std::vector<record> records = ...;
+ * s.call_batch(&records[0], records.size());
+ * @endcode
+ *
+ * \note A @ref BOOST_TYPE_ERASURE_MEMBER concept for a const
+ * member function must be given with an explicit const
+ * placeholder, as in <code>has_write<void(const record&), const _self></code>.
+ */
+template<class Op, class T =
+#ifdef BOOST_TYPE_ERASURE_DOXYGEN
+    unspecified
+#else
+    typename ::boost::remove_const<
+        typename ::boost::type_erasure::detail::batch_traits<Op>::placeholder
+    >::type
+#endif
+>
+struct batched
+{
+    typedef typename ::boost::type_erasure::detail::batch_traits<Op>::placeholder placeholder;
+    typedef typename ::boost::type_erasure::detail::batch_traits<Op>::pointer pointer;
+    static void apply(
+        typename ::boost::mpl::if_< ::boost::is_const<placeholder>, const T, T>::type& arg,
+        pointer first, std::size_t n)
+    {
+        typedef typename ::boost::type_erasure::detail::rebind_placeholders<
+            Op,
+            ::boost::mpl::map1<
+                ::boost::mpl::pair<typename ::boost::remove_const<placeholder>::type, T>
+            >
+        >::type op_type;
+        for(std::size_t i = 0; i < n; ++i) {
+            op_type::apply(arg, first[i]);
+        }
+    }
+};
+
+/// \cond show_operators
+
+template<class Op, class T, class Base, class Enable>
+struct concept_interface<batched<Op, T>, Base,
+    typename ::boost::enable_if<
+        detail::should_be_non_const<typename batched<Op, T>::placeholder, Base>,
+        T
+    >::type,
+    Enable
+> : Base
+{
+    typedef void _boost_type_erasure_has_call_batch;
+    void call_batch(typename batched<Op, T>::pointer first, std::size_t n)
+    {
+        ::boost::type_erasure::call(batched<Op, T>(), *this, first, n);
+    }
+};
+
+template<class Op, class T, class Base, class Enable>
+struct concept_interface<batched<Op, T>, Base,
+    typename ::boost::enable_if<
+        detail::should_be_const<typename batched<Op, T>::placeholder, Base>,
+        T
+    >::type,
+    Enable
+> : Base
+{
+    typedef void _boost_type_erasure_has_call_batch;
+    void call_batch(typename batched<Op, T>::pointer first, std::size_t n) const
+    {
+        ::boost::type_erasure::call(batched<Op, T>(), *this, first, n);
+    }
+};
+
+template<class Op, class T, class Base>
+struct concept_interface<batched<Op, T>, Base,
+    typename ::boost::enable_if<
+        detail::should_be_non_const<typename batched<Op, T>::placeholder, Base>,
+        T
+    >::type,
+    typename Base::_boost_type_erasure_has_call_batch
+> : Base
+{
+    using Base::call_batch;
+    void call_batch(typename batched<Op, T>::pointer first, std::size_t n)
+    {
+        ::boost::type_erasure::call(batched<Op, T>(), *this, first, n);
+    }
+};
+
+template<class Op, class T, class Base>
+struct concept_interface<batched<Op, T>, Base,
+    typename ::boost::enable_if<
+        detail::should_be_const<typename batched<Op, T>::placeholder, Base>,
+        T
+    >::type,
+    typename Base::_boost_type_erasure_has_call_batch
+> : Base
+{
+    using Base::call_batch;
+    void call_batch(typename batched<Op, T>::pointer first, std::size_t n) const
+    {
+        ::boost::type_erasure::call(batched<Op, T>(), *this, first, n);
+    }
+};
+
+/// \endcond
+
+}
+}
+
+#endif
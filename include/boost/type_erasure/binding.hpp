@@ -11,9 +11,9 @@
 #ifndef BOOST_TYPE_ERASURE_BINDING_HPP_INCLUDED
 #define BOOST_TYPE_ERASURE_BINDING_HPP_INCLUDED
 
+#include <new>
 #include <boost/config.hpp>
-#include <boost/shared_ptr.hpp>
-#include <boost/make_shared.hpp>
+#include <boost/throw_exception.hpp>
 #include <boost/utility/enable_if.hpp>
 #include <boost/mpl/transform.hpp>
 #include <boost/mpl/find_if.hpp>
@@ -23,6 +23,7 @@
 #include <boost/mpl/bool.hpp>
 #include <boost/mpl/pair.hpp>
 #include <boost/type_traits/is_same.hpp>
+#include <boost/type_erasure/exception.hpp>
 #include <boost/type_erasure/static_binding.hpp>
 #include <boost/type_erasure/is_subconcept.hpp>
 #include <boost/type_erasure/detail/adapt_to_vtable.hpp>
@@ -32,6 +33,7 @@
 #include <boost/type_erasure/detail/normalize.hpp>
 #include <boost/type_erasure/detail/instantiate.hpp>
 #include <boost/type_erasure/detail/check_map.hpp>
+#include <boost/type_erasure/detail/converted_table.hpp>
 
 namespace boost {
 namespace type_erasure {
@@ -122,7 +124,9 @@ public:
      *      referred to by @c Concept.  The mapped type should be the
      *      corresponding placeholder in Concept2.
      *
-     * \throws std::bad_alloc
+     * \throws std::bad_alloc only the first time that
+     *         the bindings of a given type are converted.
+     *         The converted table is reused afterwards.
      */
     template<class Concept2, class Map>
     binding(const binding<Concept2>& other, const Map&
@@ -149,7 +153,9 @@ public:
      *      referred to by @c Concept.  The mapped type should be the
      *      corresponding placeholder in Concept2.
      *
-     * \throws std::bad_alloc
+     * \throws std::bad_alloc only the first time that
+     *         the bindings of a given type are converted.
+     *         The converted table is reused afterwards.
      */
     template<class Concept2, class Map>
     binding(const binding<Concept2>& other, const static_binding<Map>&
@@ -187,6 +193,22 @@ public:
         )
     {}
 
+    // Used by try_dynamic_any_cast.  Instead of throwing,
+    // leaves the binding invalid, in which case it may
+    // only be destroyed.
+    /** INTERNAL ONLY */
+    template<class Placeholders, class Map>
+    binding(const dynamic_binding<Placeholders>& other, const static_binding<Map>&, const std::nothrow_t&)
+      : impl(
+            other,
+            static_binding<Map>(),
+            std::nothrow
+        )
+    {}
+    /** INTERNAL ONLY */
+    bool _boost_type_erasure_is_valid() const { return impl.table != 0; }
+    /** INTERNAL ONLY */
+    const void* _boost_type_erasure_table_address() const { return impl.table; }
     /**
      * \return true iff the sets of types that the placeholders
      *         bind to are the same for both arguments.
@@ -194,7 +216,13 @@ public:
      * \throws Nothing.
      */
     friend bool operator==(const binding& lhs, const binding& rhs)
-    { return *lhs.impl.table == *rhs.impl.table; }
+    {
+        // Equal static tables and equal converted tables
+        // are the same object, so the entries only need
+        // to be compared when one of each is involved.
+        return lhs.impl.table == rhs.impl.table ||
+            *lhs.impl.table == *rhs.impl.table;
+    }
     
     /**
      * \return true iff the arguments do not map to identical
@@ -208,6 +236,18 @@ public:
     /** INTERNAL ONLY */
     template<class T>
     typename T::type find() const { return impl.table->lookup((T*)0); }
+    /** INTERNAL ONLY */
+    template<class T>
+    const ::boost::type_erasure::detail::object_traits& find_traits() const
+    { return impl.table->lookup_info((::boost::type_erasure::destructible<T>*)0); }
+    /** INTERNAL ONLY */
+    template<class T>
+    const typename ::boost::type_erasure::detail::vtable_info<T>::type& find_info() const
+    { return impl.table->lookup_info((T*)0); }
+    /** INTERNAL ONLY */
+    template<class T>
+    const ::boost::type_erasure::detail::type_token& find_type_token() const
+    { return impl.table->lookup_info((::boost::type_erasure::typeid_<T>*)0); }
 private:
     template<class C2>
     friend class binding;
@@ -246,37 +286,49 @@ private:
         }
         template<class Concept2, class Map>
         impl_type(const binding<Concept2>& other, const static_binding<Map>&, boost::mpl::false_)
-          : manager(new table_type)
         {
-            manager->template convert_from<
+            table = ::boost::type_erasure::detail::converted_table_cache<
+                table_type,
                 typename ::boost::type_erasure::detail::convert_deductions<
                     Map,
                     placeholder_subs,
                     typename binding<Concept2>::placeholder_subs
-                >::type
-            >(*other.impl.table);
-            table = manager.get();
+                >::type,
+                typename binding<Concept2>::table_type
+            >::get(other.impl.table);
         }
         template<class PlaceholderList, class Map>
         impl_type(const dynamic_binding<PlaceholderList>& other, const static_binding<Map>&)
-          : manager(new table_type)
         {
-            manager->template convert_from<
+            // the table is owned by the conversion cache
+            table = other.impl.template get_converted_table<
+                table_type,
                 // FIXME: What do we need to do with deduced placeholder in other
                 typename ::boost::type_erasure::detail::add_deductions<
                     Map,
                     placeholder_subs
                 >::type
-            >(other.impl);
-            table = manager.get();
+            >();
+            if(table == 0) {
+                BOOST_THROW_EXCEPTION(::boost::type_erasure::bad_any_cast());
+            }
+        }
+        template<class PlaceholderList, class Map>
+        impl_type(const dynamic_binding<PlaceholderList>& other, const static_binding<Map>&, const std::nothrow_t&)
+        {
+            table = other.impl.template get_converted_table<
+                table_type,
+                typename ::boost::type_erasure::detail::add_deductions<
+                    Map,
+                    placeholder_subs
+                >::type
+            >();
         }
         template<class Concept2, class Map>
         impl_type(const binding<Concept2>& other, const static_binding<Map>&, boost::mpl::true_)
-          : table(other.impl.table),
-            manager(other.impl.manager)
+          : table(other.impl.table)
         {}
         const table_type* table;
-        ::boost::shared_ptr<table_type> manager;
     } impl;
 };
 
@@ -0,0 +1,162 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#ifndef BOOST_TYPE_ERASURE_BLOCK_RANGE_HPP_INCLUDED
+#define BOOST_TYPE_ERASURE_BLOCK_RANGE_HPP_INCLUDED
+
+#include <cstddef>
+#include <algorithm>
+#include <iterator>
+#include <boost/utility/enable_if.hpp>
+#include <boost/type_erasure/call.hpp>
+#include <boost/type_erasure/concept_interface.hpp>
+#include <boost/type_erasure/placeholder.hpp>
+#include <boost/type_erasure/detail/const.hpp>
+
+namespace boost {
+namespace type_erasure {
+
+/**
+ * The @ref block_readable concept reads a sequence of
+ * @c Value in blocks, so that a loop over a type erased
+ * sequence makes one indirect call per block instead of
+ * several per element.
+ *
+ * @c apply copies up to @c n of the next elements to
+ * @c out, consumes them, and returns how many it copied.
+ * It returns less than @c n only at the end of the
+ * sequence.  The contained type must have a member
+ * function @c next_block that does this, such as
+ * @ref block_range.
+ *
+ * Example:
+ *
+ * @code
+ * any<mpl::vector<copy_constructible<>, block_readable<int> > > source =
+ *     make_block_range(v.begin(), v.end());
+ * int buffer[256];
+ * while(std::size_t n = source.next_block(buffer, 256)) {
+ *     for(std::size_t i = 0; i < n; ++i) { ... }
+ * }
+ * @endcode
+ *
+ * \pre @c Value is not a placeholder.
+ */
+template<class Value, class T = _self>
+struct block_readable
+{
+    static std::size_t apply(T& arg, Value* out, std::size_t n)
+    {
+        return arg.next_block(out, n);
+    }
+};
+
+/// \cond show_operators
+
+template<class Value, class T, class Base>
+struct concept_interface<block_readable<Value, T>, Base, T,
+    typename ::boost::enable_if<
+        detail::should_be_non_const<T, Base>
+    >::type
+> : Base
+{
+    std::size_t next_block(Value* out, std::size_t n)
+    {
+        return ::boost::type_erasure::call(block_readable<Value, T>(), *this, out, n);
+    }
+};
+
+template<class Value, class T, class Base>
+struct concept_interface<block_readable<Value, T>, Base, T,
+    typename ::boost::enable_if<
+        detail::should_be_const<T, Base>
+    >::type
+> : Base
+{
+    std::size_t next_block(Value* out, std::size_t n) const
+    {
+        return ::boost::type_erasure::call(block_readable<Value, T>(), *this, out, n);
+    }
+};
+
+/// \endcond
+
+namespace detail {
+
+template<class Iter, class Value>
+std::size_t copy_block(Iter& first, Iter last, Value* out, std::size_t n,
+    std::random_access_iterator_tag)
+{
+    std::size_t result = (std::min)(n, static_cast<std::size_t>(last - first));
+    std::copy(first, first + result, out);
+    first += result;
+    return result;
+}
+
+template<class Iter, class Value>
+std::size_t copy_block(Iter& first, Iter last, Value* out, std::size_t n,
+    std::input_iterator_tag)
+{
+    std::size_t result = 0;
+    for(; result < n && first != last; ++result, ++first) {
+        out[result] = *first;
+    }
+    return result;
+}
+
+}
+
+/**
+ * Models @ref block_readable for the elements of
+ * <code>[first, last)</code>.  The loop that copies each
+ * block runs on the concrete iterators.
+ */
+template<class Iter>
+class block_range
+{
+public:
+    block_range(Iter first_arg, Iter last_arg)
+      : first(first_arg),
+        last(last_arg)
+    {}
+    /**
+     * Copies up to @c n of the remaining elements to
+     * @c out and advances past them.
+     *
+     * \return The number of elements copied.
+     */
+    template<class Value>
+    std::size_t next_block(Value* out, std::size_t n)
+    {
+        return ::boost::type_erasure::detail::copy_block(first, last, out, n,
+            typename std::iterator_traits<Iter>::iterator_category());
+    }
+    /** \return The remaining elements. */
+    Iter begin() const { return first; }
+    /** \return The end of the elements. */
+    Iter end() const { return last; }
+private:
+    Iter first;
+    Iter last;
+};
+
+/**
+ * \return <code>block_range<Iter>(first, last)</code>
+ */
+template<class Iter>
+block_range<Iter> make_block_range(Iter first, Iter last)
+{
+    return block_range<Iter>(first, last);
+}
+
+}
+}
+
+#endif
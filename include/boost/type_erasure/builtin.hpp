@@ -43,11 +43,13 @@ template<class T = _self>
 struct destructible
 {
     /** INTERNAL ONLY */
-    typedef void (*type)(detail::storage&);
+    typedef void (*type)(detail::storage&, const detail::storage_space&,
+        detail::storage*, const detail::storage_space&);
     /** INTERNAL ONLY */
-    static void value(detail::storage& arg)
+    static void value(detail::storage& arg, const detail::storage_space& space,
+        detail::storage* dest, const detail::storage_space& dest_space)
     {
-        delete static_cast<T*>(arg.data);
+        ::boost::type_erasure::detail::manage_storage<T>(arg, space, dest, dest_space);
     }
     /** INTERNAL ONLY */
     static void apply(detail::storage& arg)
@@ -163,7 +165,13 @@ struct get_null_vtable_entry< ::boost::type_erasure::typeid_<T> >
 };
 
 struct null_destroy {
-    static void value(::boost::type_erasure::detail::storage&) {}
+    static void value(::boost::type_erasure::detail::storage&,
+        const ::boost::type_erasure::detail::storage_space&,
+        ::boost::type_erasure::detail::storage* dest,
+        const ::boost::type_erasure::detail::storage_space&)
+    {
+        if(dest != 0) dest->data = 0;
+    }
 };
 
 template<class T>
@@ -17,6 +17,16 @@
 #include <boost/mpl/bool.hpp>
 #include <boost/mpl/eval_if.hpp>
 #include <boost/mpl/identity.hpp>
+#include <boost/mpl/not.hpp>
+#include <boost/mpl/assert.hpp>
+#include <boost/mpl/begin_end.hpp>
+#include <boost/mpl/deref.hpp>
+#include <boost/mpl/map.hpp>
+#include <boost/mpl/pair.hpp>
+#include <boost/mpl/set.hpp>
+#include <boost/mpl/size.hpp>
+#include <boost/type_traits/is_reference.hpp>
+#include <boost/type_traits/is_same.hpp>
 #include <boost/type_traits/remove_cv.hpp>
 #include <boost/type_traits/remove_reference.hpp>
 #include <boost/preprocessor/cat.hpp>
@@ -34,10 +44,14 @@
 #include <boost/type_erasure/detail/extract_concept.hpp>
 #include <boost/type_erasure/detail/get_signature.hpp>
 #include <boost/type_erasure/detail/check_call.hpp>
+#include <boost/type_erasure/detail/get_placeholders.hpp>
+#include <boost/type_erasure/detail/rebind_placeholders.hpp>
 #include <boost/type_erasure/is_placeholder.hpp>
 #include <boost/type_erasure/concept_of.hpp>
 #include <boost/type_erasure/config.hpp>
 #include <boost/type_erasure/require_match.hpp>
+#include <boost/type_erasure/closed.hpp>
+#include <boost/type_erasure/relaxed.hpp>
 
 namespace boost {
 namespace type_erasure {
@@ -264,6 +278,64 @@ template<class Op, class... U>
 typename ::boost::type_erasure::detail::call_impl<Sig, U...>::type
 call(const Op&, U&&... args);
 
+/**
+ * Equivalent to \call, except that before calling through
+ * the vtable it checks whether the function is the one for
+ * @c T and, if it is, calls it directly.  The direct call
+ * can be inlined, so this helps call sites where most
+ * objects hold a @c T.  If the guess is wrong, the cost
+ * is one extra comparison.
+ *
+ * Example:
+ *
+ * @code
+ * any<mpl::vector<copy_constructible<>, incrementable<> > > x = ...;
+ * guarded_call<int>(incrementable<>(), x);
+ * @endcode
+ *
+ * \pre The signature of @c Op has exactly one placeholder,
+ *      which @c T is bound to.
+ *
+ * \note This needs variadic templates and rvalue references.
+ */
+template<class T, class Concept, class Op, class... U>
+typename ::boost::type_erasure::detail::call_impl<Sig, U..., Concept>::type
+guarded_call(const binding<Concept>& binding_arg, const Op&, U&&... args);
+
+/**
+ * \overload
+ */
+template<class T, class Op, class... U>
+typename ::boost::type_erasure::detail::call_impl<Sig, U...>::type
+guarded_call(const Op&, U&&... args);
+
+/**
+ * Equivalent to <code>dest = call(binding_arg, f, args...)</code>,
+ * except that the result does not need an @ref any of its own.
+ * If @c dest has the result type of @c Op, and holds an object
+ * of the same type as the result, which no other @ref any
+ * shares, the result is moved into that object's storage.
+ * This lets a loop such as <code>call_into(z, addable<>(), x, y)</code>
+ * run without allocating.  The arguments may refer to @c dest.
+ *
+ * \throws Whatever @ref call throws.  If the result replaces
+ *         the object held by @c dest, @c dest is unchanged
+ *         when an exception is thrown.
+ *
+ * \note The object is only replaced when @c Concept includes
+ *       @ref relaxed and the result type can be moved without
+ *       throwing.  This needs variadic templates, rvalue references
+ *       and inheriting constructors.
+ */
+template<class Dest, class Concept, class Op, class... U>
+void call_into(Dest& dest, const binding<Concept>& binding_arg, const Op& f, U&&... args);
+
+/**
+ * \overload
+ */
+template<class Dest, class Op, class... U>
+void call_into(Dest& dest, const Op& f, U&&... args);
+
 #else
 
 namespace detail {
@@ -341,6 +413,61 @@ extract_table(R(*)(T...), const U&... arg)
 
 #endif
 
+// The placeholder of F, which must have only one.
+template<class F>
+struct single_placeholder
+{
+#ifndef BOOST_TYPE_ERASURE_USE_MP11
+    typedef typename ::boost::type_erasure::detail::get_placeholders<
+        F, ::boost::mpl::set0<> >::type placeholders;
+    BOOST_MPL_ASSERT_RELATION(::boost::mpl::size<placeholders>::value, ==, 1);
+    typedef typename ::boost::mpl::deref<
+        typename ::boost::mpl::begin<placeholders>::type>::type type;
+#else
+    typedef typename ::boost::type_erasure::detail::get_placeholders<
+        F, ::boost::mp11::mp_list<> >::type placeholders;
+    BOOST_MPL_ASSERT_RELATION(::boost::mp11::mp_size<placeholders>::value, ==, 1);
+    typedef ::boost::mp11::mp_front<placeholders> type;
+#endif
+};
+
+// Calls the entry F of table with arg.  If Guess is not
+// void, the entry is first compared with the implementation
+// of F for Guess, which is called directly when it matches.
+template<class F, class Guess>
+struct guarded_entry
+{
+    typedef typename ::boost::type_erasure::detail::vtable_result<
+        typename F::type>::type result_type;
+    template<class Concept, class... A>
+    static result_type apply(const ::boost::type_erasure::binding<Concept>& table, A&&... arg)
+    {
+        typedef typename ::boost::type_erasure::detail::rebind_placeholders<
+            F,
+            ::boost::mpl::map1< ::boost::mpl::pair<
+                typename ::boost::type_erasure::detail::single_placeholder<F>::type,
+                Guess> >
+        >::type direct;
+        typename F::type f = table.template find<F>();
+        if(f == &direct::value) {
+            return direct::value(std::forward<A>(arg)...);
+        }
+        return f(std::forward<A>(arg)...);
+    }
+};
+
+template<class F>
+struct guarded_entry<F, void>
+{
+    typedef typename ::boost::type_erasure::detail::vtable_result<
+        typename F::type>::type result_type;
+    template<class Concept, class... A>
+    static result_type apply(const ::boost::type_erasure::binding<Concept>& table, A&&... arg)
+    {
+        return ::boost::type_erasure::detail::call_entry<F>(table, std::forward<A>(arg)...);
+    }
+};
+
 template<class Sig, class Args, class Concept, bool ReturnsAny>
 struct call_impl_dispatch;
 
@@ -348,27 +475,128 @@ template<class R, class... T, class... U, class Concept>
 struct call_impl_dispatch<R(T...), void(U...), Concept, false>
 {
     typedef R type;
-    template<class F>
+    template<class F, class Guess = void>
     static R apply(const ::boost::type_erasure::binding<Concept>* table, U... arg)
     {
-        return table->template find<F>()(
+        return ::boost::type_erasure::detail::guarded_entry<F, Guess>::apply(*table,
             ::boost::type_erasure::detail::convert_arg(
                 ::std::forward<U>(arg),
                 ::boost::type_erasure::detail::is_placeholder_arg<T>())...);
     }
+    template<class F, class Guess, class Dest>
+    static void apply_into(Dest& dest, const ::boost::type_erasure::binding<Concept>* table, U... arg)
+    {
+        dest = apply<F, Guess>(table, ::std::forward<U>(arg)...);
+    }
 };
 
+// Only constructible returns storage directly.  Its vtable
+// entry takes the space to construct the object in.
+template<class... T, class... U, class Concept>
+struct call_impl_dispatch< ::boost::type_erasure::detail::storage(T...), void(U...), Concept, false>
+{
+    typedef ::boost::type_erasure::detail::storage type;
+    template<class F, class Guess = void>
+    static type apply(const ::boost::type_erasure::binding<Concept>* table, U... arg)
+    {
+        return apply_in<F, Guess>(
+            ::boost::type_erasure::detail::storage_space(), table, ::std::forward<U>(arg)...);
+    }
+    template<class F, class Guess = void>
+    static type apply_in(
+        const ::boost::type_erasure::detail::storage_space& space,
+        const ::boost::type_erasure::binding<Concept>* table, U... arg)
+    {
+        return ::boost::type_erasure::detail::guarded_entry<F, Guess>::apply(*table,
+            space,
+            ::boost::type_erasure::detail::convert_arg(
+                ::std::forward<U>(arg),
+                ::boost::type_erasure::detail::is_placeholder_arg<T>())...);
+    }
+};
+
+// Tells the constructor of any to create the result of
+// Impl::apply_in<F, Guess> in its own storage.
+template<class Impl, class F, class Guess>
+struct result_in_place {};
+
+// Whether an any<Concept, R> can construct a result in place.
+template<class R>
+struct constructs_result_in_place :
+#ifdef BOOST_TYPE_ERASURE_SFINAE_FRIENDLY_CONSTRUCTORS
+    ::boost::mpl::not_< ::boost::is_reference<R> >
+#else
+    ::boost::mpl::false_
+#endif
+{};
+
 template<class R, class... T, class... U, class Concept>
 struct call_impl_dispatch<R(T...), void(U...), Concept, true>
 {
     typedef ::boost::type_erasure::any<Concept, R> type;
-    template<class F>
+    template<class F, class Guess = void>
     static type apply(const ::boost::type_erasure::binding<Concept>* table, U... arg)
     {
-        return type(table->template find<F>()(
+        return make_result<F, Guess>(
+            ::boost::type_erasure::detail::constructs_result_in_place<R>(),
+            table, ::std::forward<U>(arg)...);
+    }
+    template<class F, class Guess = void>
+    static ::boost::type_erasure::detail::storage apply_in(
+        const ::boost::type_erasure::detail::storage_space& space,
+        const ::boost::type_erasure::binding<Concept>* table, U... arg)
+    {
+        return ::boost::type_erasure::detail::guarded_entry<F, Guess>::apply(*table,
+            space,
             ::boost::type_erasure::detail::convert_arg(
                 ::std::forward<U>(arg),
-                ::boost::type_erasure::detail::is_placeholder_arg<T>())...), *table);
+                ::boost::type_erasure::detail::is_placeholder_arg<T>())...);
+    }
+    // A relaxed any of the result type can take the result
+    // in place of the object that it holds.
+    template<class F, class Guess, class Dest>
+    static void apply_into(Dest& dest, const ::boost::type_erasure::binding<Concept>* table, U... arg)
+    {
+        assign_result<F, Guess>(dest,
+            ::boost::mpl::bool_<
+                ::boost::is_same<Dest, type>::value &&
+                ::boost::type_erasure::is_relaxed<Concept>::value &&
+                ::boost::type_erasure::detail::constructs_result_in_place<R>::value
+            >(),
+            table, ::std::forward<U>(arg)...);
+    }
+private:
+    template<class F, class Guess>
+    static void assign_result(type& dest, ::boost::mpl::true_,
+        const ::boost::type_erasure::binding<Concept>* table, U... arg)
+    {
+        ::boost::type_erasure::detail::access::assign_result(dest,
+            ::boost::type_erasure::detail::result_in_place<call_impl_dispatch, F, Guess>(),
+            *table, ::std::forward<U>(arg)...);
+    }
+    template<class F, class Guess, class Dest>
+    static void assign_result(Dest& dest, ::boost::mpl::false_,
+        const ::boost::type_erasure::binding<Concept>* table, U... arg)
+    {
+        dest = make_result<F, Guess>(
+            ::boost::type_erasure::detail::constructs_result_in_place<R>(),
+            table, ::std::forward<U>(arg)...);
+    }
+    template<class F, class Guess>
+    static type make_result(::boost::mpl::true_,
+        const ::boost::type_erasure::binding<Concept>* table, U... arg)
+    {
+        return type(
+            ::boost::type_erasure::detail::result_in_place<call_impl_dispatch, F, Guess>(),
+            *table, ::std::forward<U>(arg)...);
+    }
+    template<class F, class Guess>
+    static type make_result(::boost::mpl::false_,
+        const ::boost::type_erasure::binding<Concept>* table, U... arg)
+    {
+        return type(apply_in<F, Guess>(
+            ::boost::type_erasure::detail::storage_space(),
+            table, ::std::forward<U>(arg)...), *table);
     }
 };
 
@@ -490,6 +718,135 @@ call(
     return ::boost::type_erasure::unchecked_call(f, std::forward<U>(arg)...);
 }
 
+template<class T, class Concept, class Op, class... U>
+typename ::boost::type_erasure::detail::call_result<
+    Op,
+    void(U&&...),
+    Concept
+>::type
+guarded_call(
+    const ::boost::type_erasure::binding<Concept>& table,
+    const Op& f,
+    U&&... arg)
+{
+    ::boost::type_erasure::require_match(table, f, std::forward<U>(arg)...);
+    return ::boost::type_erasure::detail::call_impl<
+        typename ::boost::type_erasure::detail::get_signature<Op>::type,
+        void(U&&...),
+        Concept
+    >::template apply<
+        typename ::boost::type_erasure::detail::adapt_to_vtable<Op>::type,
+        T
+    >(&table, std::forward<U>(arg)...);
+}
+
+template<class T, class Op, class... U>
+typename ::boost::type_erasure::detail::call_result<
+    Op,
+    void(U&&...)
+>::type
+guarded_call(
+    const Op& f,
+    U&&... arg)
+{
+    ::boost::type_erasure::require_match(f, std::forward<U>(arg)...);
+    return ::boost::type_erasure::detail::call_impl<
+        typename ::boost::type_erasure::detail::get_signature<Op>::type,
+        void(U&&...)
+    >::template apply<
+        typename ::boost::type_erasure::detail::adapt_to_vtable<Op>::type,
+        T
+    >(::boost::type_erasure::detail::extract_table(
+        static_cast<typename ::boost::type_erasure::detail::get_signature<Op>::type*>(0), arg...),
+        std::forward<U>(arg)...);
+}
+
+template<class Dest, class Concept, class Op, class... U>
+void call_into(
+    Dest& dest,
+    const ::boost::type_erasure::binding<Concept>& table,
+    const Op& f,
+    U&&... arg)
+{
+    ::boost::type_erasure::require_match(table, f, std::forward<U>(arg)...);
+    ::boost::type_erasure::detail::call_impl<
+        typename ::boost::type_erasure::detail::get_signature<Op>::type,
+        void(U&&...),
+        Concept
+    >::template apply_into<
+        typename ::boost::type_erasure::detail::adapt_to_vtable<Op>::type,
+        void
+    >(dest, &table, std::forward<U>(arg)...);
+}
+
+template<class Dest, class Op, class... U>
+void call_into(
+    Dest& dest,
+    const Op& f,
+    U&&... arg)
+{
+    ::boost::type_erasure::require_match(f, std::forward<U>(arg)...);
+    ::boost::type_erasure::detail::call_impl<
+        typename ::boost::type_erasure::detail::get_signature<Op>::type,
+        void(U&&...)
+    >::template apply_into<
+        typename ::boost::type_erasure::detail::adapt_to_vtable<Op>::type,
+        void
+    >(dest, ::boost::type_erasure::detail::extract_table(
+        static_cast<typename ::boost::type_erasure::detail::get_signature<Op>::type*>(0), arg...),
+        std::forward<U>(arg)...);
+}
+
+namespace detail {
+
+// Equivalent to call for a constructible, except that the
+// new object is placed in space.
+template<class Concept, class Op, class... U>
+typename ::boost::type_erasure::detail::call_result<
+    Op,
+    void(U&&...),
+    Concept
+>::type
+construct_in(
+    const ::boost::type_erasure::detail::storage_space& space,
+    const ::boost::type_erasure::binding<Concept>& table,
+    const Op& f,
+    U&&... arg)
+{
+    ::boost::type_erasure::require_match(table, f, std::forward<U>(arg)...);
+    return ::boost::type_erasure::detail::call_impl<
+        typename ::boost::type_erasure::detail::get_signature<Op>::type,
+        void(U&&...),
+        Concept
+    >::template apply_in<
+        typename ::boost::type_erasure::detail::adapt_to_vtable<Op>::type
+    >(space, &table, std::forward<U>(arg)...);
+}
+
+template<class Op, class... U>
+typename ::boost::type_erasure::detail::call_result<
+    Op,
+    void(U&&...)
+>::type
+construct_in(
+    const ::boost::type_erasure::detail::storage_space& space,
+    const Op& f,
+    U&&... arg)
+{
+    ::boost::type_erasure::require_match(f, std::forward<U>(arg)...);
+    return ::boost::type_erasure::detail::call_impl<
+        typename ::boost::type_erasure::detail::get_signature<Op>::type,
+        void(U&&...)
+    >::template apply_in<
+        typename ::boost::type_erasure::detail::adapt_to_vtable<Op>::type
+    >(space,
+        ::boost::type_erasure::detail::extract_table(
+        static_cast<typename ::boost::type_erasure::detail::get_signature<Op>::type*>(0), arg...),
+        std::forward<U>(arg)...);
+}
+
+}
+
 
 #else
 
@@ -596,6 +953,30 @@ struct BOOST_PP_CAT(call_impl, N)<
     }
 };
 
+template<
+    class Concept
+    BOOST_PP_ENUM_TRAILING_PARAMS(N, class T)
+    BOOST_PP_ENUM_TRAILING_PARAMS(N, class U)
+>
+struct BOOST_PP_CAT(call_impl, N)<
+    ::boost::type_erasure::detail::storage
+    BOOST_PP_ENUM_TRAILING_PARAMS(N, T)
+    BOOST_PP_ENUM_TRAILING_PARAMS(N, U),
+    Concept,
+    false
+>
+{
+    typedef ::boost::type_erasure::detail::storage type;
+    template<class F>
+    static type apply(const ::boost::type_erasure::binding<Concept>* table
+        BOOST_PP_ENUM_TRAILING_BINARY_PARAMS(N, U, arg))
+    {
+        return table->template find<F>()(
+            ::boost::type_erasure::detail::storage_space()
+            BOOST_PP_ENUM_TRAILING(N, BOOST_TYPE_ERASURE_CONVERT_ARG, ~));
+    }
+};
+
 template<
     class R
     BOOST_PP_ENUM_TRAILING_PARAMS(N, class T)
@@ -616,7 +997,8 @@ struct BOOST_PP_CAT(call_impl, N)<
         BOOST_PP_ENUM_TRAILING_BINARY_PARAMS(N, U, arg))
     {
         return type(table->template find<F>()(
-            BOOST_PP_ENUM(N, BOOST_TYPE_ERASURE_CONVERT_ARG, ~)), *table);
+            ::boost::type_erasure::detail::storage_space()
+            BOOST_PP_ENUM_TRAILING(N, BOOST_TYPE_ERASURE_CONVERT_ARG, ~)), *table);
     }
 };
 
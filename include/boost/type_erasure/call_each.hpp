@@ -0,0 +1,161 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#ifndef BOOST_TYPE_ERASURE_CALL_EACH_HPP_INCLUDED
+#define BOOST_TYPE_ERASURE_CALL_EACH_HPP_INCLUDED
+
+#include <cstddef>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include <boost/config.hpp>
+#include <boost/core/addressof.hpp>
+#include <boost/type_traits/remove_reference.hpp>
+#include <boost/type_erasure/detail/access.hpp>
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/binding.hpp>
+#include <boost/type_erasure/call.hpp>
+
+namespace boost {
+namespace type_erasure {
+
+namespace detail {
+
+template<class Iter>
+struct grouped_pointer
+{
+    typedef typename ::boost::remove_reference<
+        typename std::iterator_traits<Iter>::reference
+    >::type* type;
+};
+
+// Fills order with the addresses of the elements of
+// [first, last), so that the elements that share a table
+// are adjacent and keep their relative order.  Group i
+// ends at bounds[i].  The groups are found by a linear
+// search, starting with the group of the previous element,
+// which is fast when there are only a few distinct types.
+template<class Iter>
+void group_by_table(
+    Iter first, Iter last,
+    std::vector<typename ::boost::type_erasure::detail::grouped_pointer<Iter>::type>& order,
+    std::vector<std::size_t>& bounds)
+{
+    std::vector<std::size_t> groups;
+    groups.reserve(std::distance(first, last));
+    std::vector<const void*> tables;
+    std::size_t group = 0;
+    for(Iter iter = first; iter != last; ++iter) {
+        const void* table = ::boost::type_erasure::detail::access::table(*iter)
+            ._boost_type_erasure_table_address();
+        if(tables.empty() || tables[group] != table) {
+            group = std::find(tables.begin(), tables.end(), table) - tables.begin();
+            if(group == tables.size()) {
+                tables.push_back(table);
+                bounds.push_back(0);
+            }
+        }
+        groups.push_back(group);
+        ++bounds[group];
+    }
+    // Counting sort into the groups.
+    std::vector<std::size_t> pos(bounds.size());
+    std::size_t total = 0;
+    for(std::size_t i = 0; i < bounds.size(); ++i) {
+        pos[i] = total;
+        total += bounds[i];
+        bounds[i] = total;
+    }
+    order.resize(groups.size());
+    for(std::size_t i = 0; first != last; ++first, ++i) {
+        order[pos[groups[i]]++] = ::boost::addressof(*first);
+    }
+}
+
+}
+
+/**
+ * Calls @c f for every element of <code>[first, last)</code>,
+ * like @c std::for_each, except that all the elements that
+ * hold the same type are visited together.  Calls through
+ * the @ref any inside @c f then go to the same function
+ * many times in a row, which the CPU predicts well.
+ *
+ * @c Iter must be a forward iterator whose elements are
+ * @ref any "anys".  Elements with the same type are visited
+ * in their original order.  The order of the groups is the
+ * order in which their first elements appear.
+ *
+ * \return @c f
+ *
+ * \note Elements that have equal bindings, but got them from
+ * different sources, such as a @ref dynamic_binding, may be
+ * put in different groups.
+ */
+template<class Iter, class F>
+F for_each_grouped(Iter first, Iter last, F f)
+{
+    typedef typename ::boost::type_erasure::detail::grouped_pointer<Iter>::type pointer;
+    std::vector<pointer> order;
+    std::vector<std::size_t> bounds;
+    ::boost::type_erasure::detail::group_by_table(first, last, order, bounds);
+    for(std::size_t i = 0; i < order.size(); ++i) {
+        f(*order[i]);
+    }
+    return f;
+}
+
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+
+/**
+ * Equivalent to calling
+ * <code>call(f, element, args...)</code> for every
+ * element of @c range, grouped as by
+ * @ref for_each_grouped.  Each group looks up the binding
+ * once.
+ *
+ * Example:
+ *
+ * @code
+ * BOOST_TYPE_ERASURE_MEMBER(update)
+ * typedef any<mpl::vector<copy_constructible<>, has_update<void(double)> > > entity;
+ * std::vector<entity> entities = ...;
+ * call_each(has_update<void(double)>(), entities, 0.01);
+ * @endcode
+ *
+ * \pre The first argument in the signature of @c Op is a
+ *      placeholder and @c args are not @ref any "anys".
+ *
+ * \note This needs variadic templates and rvalue references.
+ */
+template<class Op, class Range, class... A>
+void call_each(const Op& f, Range&& range, A&&... args)
+{
+    typedef typename ::boost::type_erasure::detail::grouped_pointer<
+        decltype(std::begin(range))>::type pointer;
+    std::vector<pointer> order;
+    std::vector<std::size_t> bounds;
+    ::boost::type_erasure::detail::group_by_table(
+        std::begin(range), std::end(range), order, bounds);
+    std::size_t i = 0;
+    for(std::size_t group = 0; group < bounds.size(); ++group) {
+        const auto& table = ::boost::type_erasure::detail::access::table(*order[i]);
+        for(; i < bounds[group]; ++i) {
+            ::boost::type_erasure::call(table, f, *order[i], args...);
+        }
+    }
+}
+
+#endif
+
+}
+}
+
+#endif
@@ -29,6 +29,7 @@
 #include <boost/type_erasure/detail/extract_concept.hpp>
 #include <boost/type_erasure/relaxed.hpp>
 #include <boost/type_erasure/detail/access.hpp>
+#include <boost/type_erasure/detail/type_token.hpp>
 
 namespace boost {
 namespace type_erasure {
@@ -52,9 +53,8 @@ bool maybe_check_table(const T& arg, const Table*& table, boost::mpl::true_)
         table = &::boost::type_erasure::detail::access::table(arg);
         return true;
     } else {
-        return table->template find< ::boost::type_erasure::typeid_<P> >()() ==
-            ::boost::type_erasure::detail::access::table(arg).
-                template find< ::boost::type_erasure::typeid_<P> >()();
+        return ::boost::type_erasure::detail::same_bound_type<P>(
+            *table, ::boost::type_erasure::detail::access::table(arg));
     }
 }
 
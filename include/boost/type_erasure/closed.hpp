@@ -0,0 +1,333 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#ifndef BOOST_TYPE_ERASURE_CLOSED_HPP_INCLUDED
+#define BOOST_TYPE_ERASURE_CLOSED_HPP_INCLUDED
+
+#include <cstddef>
+#include <boost/config.hpp>
+#include <boost/mpl/assert.hpp>
+#include <boost/mpl/at.hpp>
+#include <boost/mpl/begin_end.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/distance.hpp>
+#include <boost/mpl/eval_if.hpp>
+#include <boost/mpl/identity.hpp>
+#include <boost/mpl/placeholders.hpp>
+#include <boost/mpl/find.hpp>
+#include <boost/mpl/find_if.hpp>
+#include <boost/mpl/deref.hpp>
+#include <boost/mpl/has_key.hpp>
+#include <boost/mpl/is_sequence.hpp>
+#include <boost/mpl/not.hpp>
+#include <boost/mpl/map.hpp>
+#include <boost/mpl/or.hpp>
+#include <boost/mpl/pair.hpp>
+#include <boost/mpl/set.hpp>
+#include <boost/mpl/size.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_void.hpp>
+#include <boost/type_erasure/placeholder.hpp>
+#include <boost/type_erasure/detail/meta.hpp>
+#include <boost/type_erasure/detail/null.hpp>
+#include <boost/type_erasure/detail/get_placeholders.hpp>
+#include <boost/type_erasure/detail/rebind_placeholders.hpp>
+#include <boost/type_erasure/detail/vtable.hpp>
+
+namespace boost {
+namespace type_erasure {
+
+template<class Concept>
+class binding;
+
+namespace detail {
+
+// The position of T in Types, or the size of Types if T
+// is not one of them.
+template<class Types, class T>
+struct closed_index :
+    ::boost::mpl::distance<
+        typename ::boost::mpl::begin<Types>::type,
+        typename ::boost::mpl::find<Types, T>::type
+    >
+{};
+
+}
+
+/**
+ * This special concept declares that the placeholder @c T
+ * is only ever bound to one of the types in the MPL
+ * sequence @c Types.  Each vtable then records the
+ * position of its type in @c Types, and \call
+ * dispatches on that position instead of calling through
+ * a function pointer, which lets the compiler inline the
+ * implementation for each type.
+ *
+ * \code
+ * typedef any<
+ *     mpl::vector<
+ *         copy_constructible<>,
+ *         incrementable<>,
+ *         closed<mpl::vector<int, long, double> >
+ *     >
+ * > number;
+ * \endcode
+ *
+ * The concept is otherwise unchanged, so @ref binding,
+ * @ref static_binding and the interfaces of the other
+ * concepts work as before.  Only functions whose
+ * placeholders are all @c T are dispatched this way.
+ *
+ * \pre Every type bound to @c T is in @c Types.  Binding
+ *      any other type is a compile time error.
+ * \pre Every type in @c Types models the rest of the
+ *      concept, since \call instantiates each function
+ *      for all of them.
+ *
+ * \note The dispatch needs variadic templates.  Bindings
+ * converted from a @ref dynamic_binding do not know the
+ * position and always call through the vtable.
+ */
+template<class Types, class T = _self>
+struct closed
+{
+    /** INTERNAL ONLY */
+    typedef std::size_t (*type)();
+    /** INTERNAL ONLY */
+    static std::size_t value()
+    {
+        BOOST_MPL_ASSERT((::boost::mpl::or_<
+            ::boost::is_void<T>,
+            ::boost::mpl::bool_<(
+                ::boost::type_erasure::detail::closed_index<Types, T>::value <
+                ::boost::mpl::size<Types>::value)>
+        >));
+        return ::boost::type_erasure::detail::closed_index<Types, T>::value;
+    }
+    /** INTERNAL ONLY */
+    static std::size_t apply() { return value(); }
+};
+
+namespace detail {
+
+// The position of the type in a closed set, plus one, so
+// that 0 means that the table does not know it.
+struct closed_position
+{
+    std::size_t value;
+};
+
+template<class Types, class T>
+struct closed_position_of
+{
+    static const closed_position value;
+};
+
+template<class Types, class T>
+const closed_position closed_position_of<Types, T>::value = {
+    ::boost::type_erasure::detail::closed_index<Types, T>::value + 1
+};
+
+template<class Types, class T>
+struct vtable_info< ::boost::type_erasure::closed<Types, T> >
+{
+    typedef ::boost::type_erasure::detail::closed_position type;
+};
+
+template<class Types, class T>
+struct vtable_info_of< ::boost::type_erasure::closed<Types, T> > :
+    ::boost::type_erasure::detail::closed_position_of<Types, T>
+{};
+
+// A null table is not in the set, so calls through it
+// reach the entries that throw.
+template<class Types, class T>
+struct get_null_vtable_entry< ::boost::type_erasure::closed<Types, T> >
+{
+    typedef ::boost::type_erasure::closed<Types, void> type;
+};
+
+template<class T>
+struct is_closed : ::boost::mpl::false_ {};
+
+template<class Types, class T>
+struct is_closed< ::boost::type_erasure::closed<Types, T> > : ::boost::mpl::true_ {};
+
+// The closed set in Concept, or void.  Like is_relaxed,
+// this searches nested sequences.
+template<class Concept, bool IsSequence = ::boost::mpl::is_sequence<Concept>::value>
+struct find_closed
+{
+    typedef void type;
+};
+
+template<class Types, class T>
+struct find_closed< ::boost::type_erasure::closed<Types, T>, false>
+{
+    typedef ::boost::type_erasure::closed<Types, T> type;
+};
+
+template<class Concept>
+struct has_closed :
+    ::boost::mpl::not_< ::boost::is_void<
+        typename ::boost::type_erasure::detail::find_closed<Concept>::type> >
+{};
+
+template<class Iter>
+struct find_closed_at
+{
+    typedef typename ::boost::type_erasure::detail::find_closed<
+        typename ::boost::mpl::deref<Iter>::type>::type type;
+};
+
+template<class Concept>
+struct find_closed<Concept, true>
+{
+    typedef typename ::boost::mpl::find_if<
+        Concept,
+        ::boost::type_erasure::detail::has_closed< ::boost::mpl::_1>
+    >::type pos;
+    typedef typename ::boost::mpl::eval_if<
+        ::boost::is_same<pos, typename ::boost::mpl::end<Concept>::type>,
+        ::boost::mpl::identity<void>,
+        ::boost::type_erasure::detail::find_closed_at<pos>
+    >::type type;
+};
+
+template<class Closed, class Binding>
+std::size_t get_closed_index(const Binding& table)
+{
+    const ::boost::type_erasure::detail::closed_position& position =
+        table.template find_info<Closed>();
+    if(position.value != 0) {
+        return position.value - 1;
+    }
+    return table.template find<Closed>()();
+}
+
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+
+template<class F>
+struct vtable_result;
+
+template<class R, class... A>
+struct vtable_result<R(*)(A...)>
+{
+    typedef R type;
+};
+
+// Whether the only placeholder of F is P.
+template<class F, class P>
+struct is_closed_over
+{
+#ifndef BOOST_TYPE_ERASURE_USE_MP11
+    typedef typename ::boost::type_erasure::detail::get_placeholders<
+        F, ::boost::mpl::set0<> >::type placeholders;
+    static const bool value =
+        ::boost::mpl::size<placeholders>::value == 1 &&
+        ::boost::mpl::has_key<placeholders, P>::value;
+#else
+    typedef typename ::boost::type_erasure::detail::get_placeholders<
+        F, ::boost::mp11::mp_list<> >::type placeholders;
+    static const bool value =
+        ::boost::mp11::mp_size<placeholders>::value == 1 &&
+        ::boost::mp11::mp_set_contains<placeholders, P>::value;
+#endif
+};
+
+// Tests the positions in order.  The compiler turns the
+// chain into a switch or a jump table.
+template<class R, class Types, class P, int N,
+    int Size = ::boost::mpl::size<Types>::value>
+struct closed_switch
+{
+    template<class F, class Binding, class... A>
+    static R apply(std::size_t index, const Binding& table, A&&... arg)
+    {
+        if(index == static_cast<std::size_t>(N)) {
+            typedef ::boost::mpl::map1< ::boost::mpl::pair<P,
+                typename ::boost::mpl::at_c<Types, N>::type> > map;
+            return ::boost::type_erasure::detail::rebind_placeholders<
+                F, map>::type::value(std::forward<A>(arg)...);
+        }
+        return ::boost::type_erasure::detail::closed_switch<R, Types, P, N + 1, Size>
+            ::template apply<F>(index, table, std::forward<A>(arg)...);
+    }
+};
+
+template<class R, class Types, class P, int Size>
+struct closed_switch<R, Types, P, Size, Size>
+{
+    template<class F, class Binding, class... A>
+    static R apply(std::size_t, const Binding& table, A&&... arg)
+    {
+        return table.template find<F>()(std::forward<A>(arg)...);
+    }
+};
+
+template<class F, class Closed, bool Enable>
+struct closed_call
+{
+    template<class R, class Binding, class... A>
+    static R apply(const Binding& table, A&&... arg)
+    {
+        return table.template find<F>()(std::forward<A>(arg)...);
+    }
+};
+
+template<class F, class Types, class P>
+struct closed_call<F, ::boost::type_erasure::closed<Types, P>, true>
+{
+    template<class R, class Binding, class... A>
+    static R apply(const Binding& table, A&&... arg)
+    {
+        return ::boost::type_erasure::detail::closed_switch<R, Types, P, 0>
+            ::template apply<F>(
+                ::boost::type_erasure::detail::get_closed_index<
+                    ::boost::type_erasure::closed<Types, P> >(table),
+                table, std::forward<A>(arg)...);
+    }
+};
+
+template<class F, class Closed>
+struct closed_call_for :
+    ::boost::type_erasure::detail::closed_call<F, Closed, false>
+{};
+
+template<class F, class Types, class P>
+struct closed_call_for<F, ::boost::type_erasure::closed<Types, P> > :
+    ::boost::type_erasure::detail::closed_call<
+        F,
+        ::boost::type_erasure::closed<Types, P>,
+        ::boost::type_erasure::detail::is_closed_over<F, P>::value
+    >
+{};
+
+// Calls the entry F of table with arg.
+template<class F, class Concept, class... A>
+typename ::boost::type_erasure::detail::vtable_result<typename F::type>::type
+call_entry(const ::boost::type_erasure::binding<Concept>& table, A&&... arg)
+{
+    return ::boost::type_erasure::detail::closed_call_for<
+        F,
+        typename ::boost::type_erasure::detail::find_closed<Concept>::type
+    >::template apply<
+        typename ::boost::type_erasure::detail::vtable_result<typename F::type>::type
+    >(table, std::forward<A>(arg)...);
+}
+
+#endif
+
+}
+
+}
+}
+
+#endif
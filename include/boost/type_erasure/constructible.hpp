@@ -14,10 +14,14 @@
 #define BOOST_TYPE_ERASURE_CONSTRUCTIBLE_HPP_INCLUDED
 
 #include <boost/detail/workaround.hpp>
+#include <boost/preprocessor/cat.hpp>
 #include <boost/preprocessor/iteration/iterate.hpp>
+#include <boost/preprocessor/repetition/enum.hpp>
 #include <boost/preprocessor/repetition/enum_params.hpp>
+#include <boost/preprocessor/repetition/enum_trailing.hpp>
 #include <boost/preprocessor/repetition/enum_binary_params.hpp>
 #include <boost/preprocessor/repetition/enum_trailing_params.hpp>
+#include <boost/preprocessor/repetition/enum_trailing_binary_params.hpp>
 #include <boost/type_erasure/detail/storage.hpp>
 #include <boost/type_erasure/call.hpp>
 #include <boost/type_erasure/concept_interface.hpp>
@@ -96,11 +100,35 @@ struct concept_interface<
 
 namespace detail {
 
+template<class R, class... T, class... U>
+struct vtable_adapter<
+    ::boost::type_erasure::constructible<R(T...)>,
+    ::boost::type_erasure::detail::storage(U...)>
+{
+    typedef ::boost::type_erasure::detail::storage (*type)(
+        const ::boost::type_erasure::detail::storage_space&, U...);
+    static ::boost::type_erasure::detail::storage
+    value(const ::boost::type_erasure::detail::storage_space& space, U... arg)
+    {
+        ::boost::type_erasure::detail::storage_allocation<R> memory(space);
+        ::boost::type_erasure::detail::storage result;
+        if(memory.address() != 0) {
+            result.data = ::new (memory.address()) R(
+                ::boost::type_erasure::detail::extract<T>(::std::forward<U>(arg))...);
+        } else {
+            result.data = new R(
+                ::boost::type_erasure::detail::extract<T>(::std::forward<U>(arg))...);
+        }
+        memory.release();
+        return result;
+    }
+};
+
 template<class... T>
 struct null_construct<void(T...)>
 {
     static ::boost::type_erasure::detail::storage
-    value(T...)
+    value(const ::boost::type_erasure::detail::storage_space&, T...)
     {
         ::boost::type_erasure::detail::storage result;
         result.data = 0;
@@ -146,6 +174,15 @@ struct get_null_vtable_entry<vtable_adapter<constructible<T(const T&)>, R(U...)>
 #define BOOST_TYPE_ERASURE_FORWARD(n) BOOST_PP_ENUM_PARAMS(n, arg)
 #endif
 
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+#define BOOST_TYPE_ERASURE_EXTRACT(z, n, data)                  \
+    ::boost::type_erasure::detail::extract<BOOST_PP_CAT(T, n)>( \
+        ::std::forward<BOOST_PP_CAT(U, n)>(BOOST_PP_CAT(arg, n)))
+#else
+#define BOOST_TYPE_ERASURE_EXTRACT(z, n, data)                  \
+    ::boost::type_erasure::detail::extract<BOOST_PP_CAT(T, n)>(BOOST_PP_CAT(arg, n))
+#endif
+
 template<class R BOOST_PP_ENUM_TRAILING_PARAMS(N, class T)>
 struct constructible<R(BOOST_PP_ENUM_PARAMS(N, T))>
 {
@@ -176,11 +213,45 @@ struct concept_interface<
 
 namespace detail {
 
+template<class R BOOST_PP_ENUM_TRAILING_PARAMS(N, class T) BOOST_PP_ENUM_TRAILING_PARAMS(N, class U)>
+struct vtable_adapter<
+    ::boost::type_erasure::constructible<R(BOOST_PP_ENUM_PARAMS(N, T))>,
+    ::boost::type_erasure::detail::storage(BOOST_PP_ENUM_PARAMS(N, U))>
+{
+    typedef ::boost::type_erasure::detail::storage (*type)(
+        const ::boost::type_erasure::detail::storage_space&
+        BOOST_PP_ENUM_TRAILING_PARAMS(N, U));
+    static ::boost::type_erasure::detail::storage
+    value(const ::boost::type_erasure::detail::storage_space& space
+        BOOST_PP_ENUM_TRAILING_BINARY_PARAMS(N, U, arg))
+    {
+        return construct(space BOOST_PP_ENUM_TRAILING(N, BOOST_TYPE_ERASURE_EXTRACT, ~));
+    }
+    // The arguments are passed to R in the same way as by
+    // constructible::apply, so that without rvalue
+    // references, R sees non-const lvalues.
+    static ::boost::type_erasure::detail::storage
+    construct(const ::boost::type_erasure::detail::storage_space& space
+        BOOST_PP_ENUM_TRAILING_BINARY_PARAMS(N, T, arg))
+    {
+        ::boost::type_erasure::detail::storage_allocation<R> memory(space);
+        ::boost::type_erasure::detail::storage result;
+        if(memory.address() != 0) {
+            result.data = ::new (memory.address()) R(BOOST_TYPE_ERASURE_FORWARD(N));
+        } else {
+            result.data = new R(BOOST_TYPE_ERASURE_FORWARD(N));
+        }
+        memory.release();
+        return result;
+    }
+};
+
 template<BOOST_PP_ENUM_PARAMS(N, class T)>
 struct null_construct<void(BOOST_PP_ENUM_PARAMS(N, T))>
 {
     static ::boost::type_erasure::detail::storage
-    value(BOOST_PP_ENUM_PARAMS(N, T))
+    value(const ::boost::type_erasure::detail::storage_space&
+        BOOST_PP_ENUM_TRAILING_PARAMS(N, T))
     {
         ::boost::type_erasure::detail::storage result;
         result.data = 0;
@@ -196,6 +267,7 @@ struct get_null_vtable_entry<vtable_adapter<constructible<T(const T&)>, R(BOOST_
 
 }
 
+#undef BOOST_TYPE_ERASURE_EXTRACT
 #undef BOOST_TYPE_ERASURE_FORWARD
 #undef BOOST_TYPE_ERASURE_FORWARD_I
 
@@ -0,0 +1,53 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#ifndef BOOST_TYPE_ERASURE_COPY_ON_WRITE_HPP_INCLUDED
+#define BOOST_TYPE_ERASURE_COPY_ON_WRITE_HPP_INCLUDED
+
+#include <boost/mpl/vector.hpp>
+
+namespace boost {
+namespace type_erasure {
+
+/**
+ * This special concept makes copies of a value @ref any
+ * share the object that they hold.  The object is copied
+ * the first time that it is accessed through a non-const
+ * @ref any while it is shared.
+ *
+ * \code
+ * typedef any<mpl::vector<copy_constructible<>, typeid_<>, copy_on_write> > any_type;
+ * any_type x(std::string(1000, 'x'));
+ * any_type y(x); // no copy
+ * any_cast<std::string&>(y) += 'y'; // copies the string
+ * \endcode
+ *
+ * @ref copy_on_write uses the same layout as @ref intrusive,
+ * with a reference count in the block.  The count is
+ * atomic, so copies can be made and destroyed from
+ * different threads.
+ *
+ * Any access through a non-const @ref any counts as
+ * mutable, including passing it as a @ref param, such as
+ * the right hand side of a binary operator.  Use a const
+ * reference to avoid the copy.  A reference obtained from
+ * @ref any_cast, or a reference @ref any, must not be used
+ * to modify the object after the @ref any was copied.
+ *
+ * \note @ref copy_on_write is only supported when the compiler
+ * provides rvalue references, variadic templates and
+ * inheriting constructors.  Otherwise it is ignored.
+ */
+struct copy_on_write : ::boost::mpl::vector0<> {};
+
+}
+}
+
+#endif
@@ -73,25 +73,31 @@ struct access
     static const typename any<Concept, T>::table_type&
     table(const ::boost::type_erasure::any_base< ::boost::type_erasure::any<Concept, T> >& arg)
     {
-        return static_cast<const ::boost::type_erasure::any<Concept, T>&>(arg)._boost_type_erasure_table;
+        return static_cast<const ::boost::type_erasure::any<Concept, T>&>(arg)._boost_type_erasure_get_table();
     }
     template<class Concept, class T>
     static ::boost::type_erasure::detail::storage&
     data(::boost::type_erasure::any_base< ::boost::type_erasure::any<Concept, T> >& arg)
     {
-        return static_cast< ::boost::type_erasure::any<Concept, T>&>(arg)._boost_type_erasure_data;
+        return static_cast< ::boost::type_erasure::any<Concept, T>&>(arg)._boost_type_erasure_get_data();
     }
     template<class Concept, class T>
     static const ::boost::type_erasure::detail::storage&
     data(const ::boost::type_erasure::any_base< ::boost::type_erasure::any<Concept, T> >& arg)
     {
-        return static_cast<const ::boost::type_erasure::any<Concept, T>&>(arg)._boost_type_erasure_data;
+        return static_cast<const ::boost::type_erasure::any<Concept, T>&>(arg)._boost_type_erasure_get_data();
     }
     template<class Concept, class T>
     static ::boost::type_erasure::detail::storage&&
     data(::boost::type_erasure::any_base< ::boost::type_erasure::any<Concept, T> >&& arg)
     {
-        return std::move(static_cast< ::boost::type_erasure::any<Concept, T>&&>(arg)._boost_type_erasure_data);
+        return std::move(static_cast< ::boost::type_erasure::any<Concept, T>&&>(arg)._boost_type_erasure_get_data());
+    }
+    template<class Concept, class T, class Tag, class... U>
+    static void assign_result(::boost::type_erasure::any<Concept, T>& arg, Tag tag,
+        const ::boost::type_erasure::binding<Concept>& table_arg, U&&... u)
+    {
+        arg._boost_type_erasure_assign_result(tag, table_arg, std::forward<U>(u)...);
     }
 #endif
     template<class Derived>
@@ -26,6 +26,7 @@
 #include <boost/preprocessor/repetition/enum_params.hpp>
 #include <boost/preprocessor/repetition/enum_trailing_params.hpp>
 #include <boost/preprocessor/repetition/enum_binary_params.hpp>
+#include <boost/preprocessor/repetition/enum_trailing_binary_params.hpp>
 #include <boost/type_erasure/detail/get_signature.hpp>
 #include <boost/type_erasure/detail/storage.hpp>
 #include <boost/type_erasure/is_placeholder.hpp>
@@ -187,22 +188,63 @@ struct vtable_adapter_impl<PrimitiveConcept, R(T...), R2(U...)>
     }
 };
 
+// Functions that return a placeholder take the space that
+// the any holding the result provides, as constructible
+// does.  A result returned by value is constructed in it,
+// so that it lands in the buffer of the any when it fits.
+// If the space names an object to replace, the result is
+// computed first and then moved into it, so the arguments
+// may refer to that object.
 template<class PrimitiveConcept, class... T, class R2, class... U>
 struct vtable_adapter_impl<PrimitiveConcept, ::boost::type_erasure::detail::storage(T...), R2(U...)>
 {
-    typedef ::boost::type_erasure::detail::storage (*type)(T...);
-    static ::boost::type_erasure::detail::storage value(T... arg)
+    typedef ::boost::type_erasure::detail::storage (*type)(
+        const ::boost::type_erasure::detail::storage_space&, T...);
+    typedef typename ::boost::remove_cv<R2>::type result_type;
+    static ::boost::type_erasure::detail::storage
+    value(const ::boost::type_erasure::detail::storage_space& space, T... arg)
     {
-        return ::boost::type_erasure::detail::storage(
-            PrimitiveConcept::apply(::boost::type_erasure::detail::extract<U>(std::forward<T>(arg))...));
+        return construct(
+            ::boost::type_erasure::detail::can_reconstruct<result_type, R2>(),
+            space, std::forward<T>(arg)...);
+    }
+    static ::boost::type_erasure::detail::storage
+    construct(::boost::mpl::true_,
+        const ::boost::type_erasure::detail::storage_space& space, T... arg)
+    {
+        if(space.replace != 0) {
+            ::boost::type_erasure::detail::storage result;
+            result.data = ::boost::type_erasure::detail::reconstruct<result_type>(space.replace,
+                PrimitiveConcept::apply(::boost::type_erasure::detail::extract<U>(std::forward<T>(arg))...));
+            return result;
+        }
+        return construct(::boost::mpl::false_(), space, std::forward<T>(arg)...);
+    }
+    static ::boost::type_erasure::detail::storage
+    construct(::boost::mpl::false_,
+        const ::boost::type_erasure::detail::storage_space& space, T... arg)
+    {
+        ::boost::type_erasure::detail::storage_allocation<result_type> memory(space);
+        ::boost::type_erasure::detail::storage result;
+        if(memory.address() != 0) {
+            result.data = ::new (memory.address()) result_type(
+                PrimitiveConcept::apply(::boost::type_erasure::detail::extract<U>(std::forward<T>(arg))...));
+        } else {
+            result.data = new result_type(
+                PrimitiveConcept::apply(::boost::type_erasure::detail::extract<U>(std::forward<T>(arg))...));
+        }
+        memory.release();
+        return result;
     }
 };
 
 template<class PrimitiveConcept, class... T, class R2, class... U>
 struct vtable_adapter_impl<PrimitiveConcept, ::boost::type_erasure::detail::storage&(T...), R2(U...)>
 {
-    typedef ::boost::type_erasure::detail::storage (*type)(T...);
-    static ::boost::type_erasure::detail::storage value(T... arg)
+    typedef ::boost::type_erasure::detail::storage (*type)(
+        const ::boost::type_erasure::detail::storage_space&, T...);
+    static ::boost::type_erasure::detail::storage
+    value(const ::boost::type_erasure::detail::storage_space&, T... arg)
     {
         ::boost::type_erasure::detail::storage result;
         typename ::boost::remove_reference<R2>::type* p =
@@ -216,8 +258,10 @@ struct vtable_adapter_impl<PrimitiveConcept, ::boost::type_erasure::detail::stor
 template<class PrimitiveConcept, class... T, class R2, class... U>
 struct vtable_adapter_impl<PrimitiveConcept, ::boost::type_erasure::detail::storage&&(T...), R2(U...)>
 {
-    typedef ::boost::type_erasure::detail::storage (*type)(T...);
-    static ::boost::type_erasure::detail::storage value(T... arg)
+    typedef ::boost::type_erasure::detail::storage (*type)(
+        const ::boost::type_erasure::detail::storage_space&, T...);
+    static ::boost::type_erasure::detail::storage
+    value(const ::boost::type_erasure::detail::storage_space&, T... arg)
     {
         ::boost::type_erasure::detail::storage result;
         R2 tmp = PrimitiveConcept::apply(::boost::type_erasure::detail::extract<U>(std::forward<T>(arg))...);
@@ -309,19 +353,30 @@ template<class PrimitiveConcept
     BOOST_PP_ENUM_TRAILING_PARAMS(N, class T)>
 struct vtable_adapter<PrimitiveConcept, ::boost::type_erasure::detail::storage(BOOST_PP_ENUM_PARAMS(N, T))>
 {
-    typedef ::boost::type_erasure::detail::storage (*type)(BOOST_PP_ENUM_PARAMS(N, T));
-    static ::boost::type_erasure::detail::storage value(BOOST_PP_ENUM_BINARY_PARAMS(N, T, arg))
+    typedef ::boost::type_erasure::detail::storage (*type)(
+        const ::boost::type_erasure::detail::storage_space&
+        BOOST_PP_ENUM_TRAILING_PARAMS(N, T));
+    static ::boost::type_erasure::detail::storage value(
+        const ::boost::type_erasure::detail::storage_space& space
+        BOOST_PP_ENUM_TRAILING_BINARY_PARAMS(N, T, arg))
     {
-#if N > 0
         typedef typename ::boost::function_traits<
             typename ::boost::type_erasure::detail::get_signature<
                 PrimitiveConcept
             >::type
         > traits;
-#endif
-        return ::boost::type_erasure::detail::storage(
-            PrimitiveConcept::apply(
-                BOOST_PP_ENUM(N, BOOST_TYPE_ERASURE_EXTRACT, ~)));
+        typedef typename ::boost::remove_cv<typename traits::result_type>::type result_type;
+        ::boost::type_erasure::detail::storage_allocation<result_type> memory(space);
+        ::boost::type_erasure::detail::storage result;
+        if(memory.address() != 0) {
+            result.data = ::new (memory.address()) result_type(
+                PrimitiveConcept::apply(BOOST_PP_ENUM(N, BOOST_TYPE_ERASURE_EXTRACT, ~)));
+        } else {
+            result.data = new result_type(
+                PrimitiveConcept::apply(BOOST_PP_ENUM(N, BOOST_TYPE_ERASURE_EXTRACT, ~)));
+        }
+        memory.release();
+        return result;
     }
 };
 
@@ -329,8 +384,12 @@ template<class PrimitiveConcept
     BOOST_PP_ENUM_TRAILING_PARAMS(N, class T)>
 struct vtable_adapter<PrimitiveConcept, ::boost::type_erasure::detail::storage&(BOOST_PP_ENUM_PARAMS(N, T))>
 {
-    typedef ::boost::type_erasure::detail::storage (*type)(BOOST_PP_ENUM_PARAMS(N, T));
-    static ::boost::type_erasure::detail::storage value(BOOST_PP_ENUM_BINARY_PARAMS(N, T, arg))
+    typedef ::boost::type_erasure::detail::storage (*type)(
+        const ::boost::type_erasure::detail::storage_space&
+        BOOST_PP_ENUM_TRAILING_PARAMS(N, T));
+    static ::boost::type_erasure::detail::storage value(
+        const ::boost::type_erasure::detail::storage_space&
+        BOOST_PP_ENUM_TRAILING_BINARY_PARAMS(N, T, arg))
     {
         typedef typename ::boost::function_traits<
             typename ::boost::type_erasure::detail::get_signature<
@@ -352,8 +411,12 @@ template<class PrimitiveConcept
     BOOST_PP_ENUM_TRAILING_PARAMS(N, class T)>
 struct vtable_adapter<PrimitiveConcept, ::boost::type_erasure::detail::storage&&(BOOST_PP_ENUM_PARAMS(N, T))>
 {
-    typedef ::boost::type_erasure::detail::storage (*type)(BOOST_PP_ENUM_PARAMS(N, T));
-    static ::boost::type_erasure::detail::storage value(BOOST_PP_ENUM_BINARY_PARAMS(N, T, arg))
+    typedef ::boost::type_erasure::detail::storage (*type)(
+        const ::boost::type_erasure::detail::storage_space&
+        BOOST_PP_ENUM_TRAILING_PARAMS(N, T));
+    static ::boost::type_erasure::detail::storage value(
+        const ::boost::type_erasure::detail::storage_space&
+        BOOST_PP_ENUM_TRAILING_BINARY_PARAMS(N, T, arg))
     {
         typedef typename ::boost::function_traits<
             typename ::boost::type_erasure::detail::get_signature<
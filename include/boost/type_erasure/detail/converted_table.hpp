@@ -0,0 +1,155 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#ifndef BOOST_TYPE_ERASURE_DETAIL_CONVERTED_TABLE_HPP_INCLUDED
+#define BOOST_TYPE_ERASURE_DETAIL_CONVERTED_TABLE_HPP_INCLUDED
+
+#include <cstddef>
+#include <boost/config.hpp>
+#include <boost/atomic.hpp>
+
+namespace boost {
+namespace type_erasure {
+namespace detail {
+
+// Holds a single copy of each distinct table of type
+// Table that has been built at runtime, so that equal
+// tables can be compared by address.  A table is only
+// added once per conversion, so a linear search is fine.
+// Like the converted tables, the copies are never freed.
+template<class Table>
+class canonical_table
+{
+public:
+    static const Table* get(const Table& table)
+    {
+        node* first = head.load(::boost::memory_order_acquire);
+        if(const node* found = find(first, 0, table)) {
+            return &found->table;
+        }
+        node* result = new node(table);
+        result->next = first;
+        node* stop = 0;
+        while(!head.compare_exchange_weak(result->next, result,
+            ::boost::memory_order_release, ::boost::memory_order_acquire))
+        {
+            if(const node* found = find(result->next, stop, table)) {
+                delete result;
+                return &found->table;
+            }
+            stop = result->next;
+        }
+        return &result->table;
+    }
+private:
+    struct node
+    {
+        explicit node(const Table& t) : table(t), next(0) {}
+        Table table;
+        node* next;
+    };
+    static const node* find(const node* first, const node* last, const Table& table)
+    {
+        for(const node* n = first; n != last; n = n->next) {
+            if(n->table == table) return n;
+        }
+        return 0;
+    }
+    static ::boost::atomic<node*> head;
+};
+
+template<class Table>
+::boost::atomic<typename canonical_table<Table>::node*> canonical_table<Table>::head;
+
+// Converting a binding to another concept builds a new
+// vtable from the functions in the source vtable.  The
+// result depends only on the source vtable, which lives
+// until the end of the program, so each one is converted
+// once and the result is kept for the rest of the program
+// as well.  This lets a binding hold a plain pointer
+// to its vtable.
+//
+// Sources that convert to equal tables share the
+// canonical_table, so bindings that hold them compare
+// equal by address.
+//
+// The converted tables for each conversion are stored in
+// a small hash table of lock-free lists keyed by the
+// address of the source table.  Lookups never lock or
+// allocate.  A new entry is pushed with compare and swap,
+// and a thread that loses the race for the same source
+// discards its own entry.  Entries are never freed, since
+// bindings in objects with static storage duration may
+// still refer to them during destruction.
+template<class Table, class Map, class Src>
+class converted_table_cache
+{
+public:
+    static const Table* get(const Src* src)
+    {
+        ::boost::atomic<node*>& head = buckets[bucket_index(src)];
+        node* first = head.load(::boost::memory_order_acquire);
+        if(const node* found = find(first, 0, src)) {
+            return found->table;
+        }
+        Table converted;
+        converted.template convert_from<Map>(*src);
+        node* result = new node(src,
+            ::boost::type_erasure::detail::canonical_table<Table>::get(converted));
+        result->next = first;
+        node* stop = 0;
+        while(!head.compare_exchange_weak(result->next, result,
+            ::boost::memory_order_release, ::boost::memory_order_acquire))
+        {
+            // Only the nodes pushed since the last attempt
+            // need to be checked.
+            if(const node* found = find(result->next, stop, src)) {
+                delete result;
+                return found->table;
+            }
+            stop = result->next;
+        }
+        return result->table;
+    }
+private:
+    struct node
+    {
+        node(const Src* s, const Table* t) : source(s), table(t), next(0) {}
+        const Src* source;
+        const Table* table;
+        node* next;
+    };
+    static const node* find(const node* first, const node* last, const Src* src)
+    {
+        for(const node* n = first; n != last; n = n->next) {
+            if(n->source == src) return n;
+        }
+        return 0;
+    }
+    static std::size_t bucket_index(const Src* src)
+    {
+        return (reinterpret_cast<std::size_t>(src) / sizeof(void*)) % bucket_count;
+    }
+    BOOST_STATIC_CONSTANT(std::size_t, bucket_count = 16);
+    // The default constructor of atomic is trivial or
+    // constexpr, so this is initialized before any dynamic
+    // initialization that could use it.
+    static ::boost::atomic<node*> buckets[bucket_count];
+};
+
+template<class Table, class Map, class Src>
+::boost::atomic<typename converted_table_cache<Table, Map, Src>::node*>
+converted_table_cache<Table, Map, Src>::buckets[converted_table_cache<Table, Map, Src>::bucket_count];
+
+}
+}
+}
+
+#endif
@@ -16,6 +16,7 @@
 #include <boost/type_erasure/detail/normalize.hpp>
 #include <boost/type_erasure/detail/adapt_to_vtable.hpp>
 #include <boost/type_erasure/detail/vtable.hpp>
+#include <boost/type_erasure/detail/converted_table.hpp>
 #include <boost/type_erasure/static_binding.hpp>
 #include <boost/type_erasure/register_binding.hpp>
 #include <boost/mpl/transform.hpp>
@@ -23,12 +24,62 @@
 #include <boost/mpl/set.hpp>
 #include <boost/mpl/for_each.hpp>
 #include <boost/mpl/index_of.hpp>
+#include <algorithm>
+#include <cstddef>
 #include <typeinfo>
 
 namespace boost {
 namespace type_erasure {
 namespace detail {
 
+template<class Table, class Map, class Src>
+struct converted_table_key {};
+
+// Forwards to the lookup of a dynamic_vtable, which
+// returns null for functions that are not registered,
+// and remembers whether that happened.
+template<class Src>
+struct checked_lookup
+{
+    template<class F>
+    typename F::type lookup(F* f) const
+    {
+        typename F::type result = src->lookup(f);
+        if(result == 0) *missing = true;
+        return result;
+    }
+    const Src* src;
+    bool* missing;
+};
+
+// Converting a dynamic binding looks up every function of
+// Table in the registry, so the result is cached.  The key
+// identifies the conversion, followed by the types that
+// src binds its placeholders to.  Returns null if some
+// function was not registered.  The table is only allocated
+// once it is known to be complete, so failure is cheap.
+template<class Table, class Map, class Src>
+const Table* get_converted_table(const Src& src)
+{
+    key_element key[Src::key_size + 1];
+    key[0] = &typeid(::boost::type_erasure::detail::converted_table_key<Table, Map, Src>);
+    src.copy_types(key + 1);
+    if(const void* result = ::boost::type_erasure::detail::lookup_table_impl(key, Src::key_size + 1)) {
+        return static_cast<const Table*>(result);
+    }
+    bool missing = false;
+    ::boost::type_erasure::detail::checked_lookup<Src> checked = { &src, &missing };
+    Table converted;
+    converted.template convert_from<Map>(checked);
+    if(missing) return 0;
+    // The cache only points to the table, which is owned by
+    // canonical_table.
+    const Table* table = ::boost::type_erasure::detail::canonical_table<Table>::get(converted);
+    const void* result = ::boost::type_erasure::detail::insert_table_impl(
+        key, Src::key_size + 1, table);
+    return static_cast<const Table*>(result);
+}
+
 #if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_CONSTEXPR) && !defined(BOOST_NO_CXX11_DEFAULTED_FUNCTIONS)
 
 template<class P>
@@ -47,19 +98,27 @@ template<class Table>
 struct append_to_key {
     template<class P>
     void operator()(P) {
-        key->push_back(static_cast<const dynamic_binding_impl<P>*>(table)->type);
+        *(*key)++ = static_cast<const dynamic_binding_impl<P>*>(table)->type;
     }
     const Table * table;
-    key_type * key;
+    key_element ** key;
 };
 
 template<class... P>
 struct dynamic_vtable : dynamic_binding_impl<P>... {
+    static const std::size_t key_size = sizeof...(P);
     dynamic_vtable() = default;
     constexpr dynamic_vtable(typename dynamic_binding_element<P>::type ...t) : dynamic_binding_impl<P>(t)... {}
+    void copy_types(key_element* out) const {
+        key_element types[] = { static_cast<const dynamic_binding_impl<P>*>(this)->type... };
+        std::copy(types, types + key_size, out);
+    }
+    template<class Table, class Map>
+    const Table* get_converted_table() const {
+        return ::boost::type_erasure::detail::get_converted_table<Table, Map>(*this);
+    }
     template<class F>
     typename F::type lookup(F*) const {
-        key_type key;
 #ifndef BOOST_TYPE_ERASURE_USE_MP11
         typedef typename ::boost::type_erasure::detail::get_placeholders<F, ::boost::mpl::set0<> >::type placeholders;
 #else
@@ -70,9 +129,12 @@ struct dynamic_vtable : dynamic_binding_impl<P>... {
             ::boost::mpl::map0<>,
             ::boost::type_erasure::detail::counting_map_appender
         >::type placeholder_map;
-        key.push_back(&typeid(typename ::boost::type_erasure::detail::rebind_placeholders<F, placeholder_map>::type));
-        ::boost::mpl::for_each<placeholders>(append_to_key<dynamic_vtable>{this, &key});
-        return reinterpret_cast<typename F::type>(lookup_function_impl(key));
+        key_element key[::boost::type_erasure::detail::key_size<placeholders>::value];
+        key_element* pos = key;
+        *pos++ = &typeid(typename ::boost::type_erasure::detail::rebind_placeholders<F, placeholder_map>::type);
+        ::boost::mpl::for_each<placeholders>(append_to_key<dynamic_vtable>{this, &pos});
+        return reinterpret_cast<typename F::type>(find_function_impl(
+            key, ::boost::type_erasure::detail::key_size<placeholders>::value));
     }
     template<class Bindings>
     void init() {
@@ -121,30 +183,42 @@ struct dynamic_vtable_initializer
 template<class Placeholders>
 struct dynamic_vtable
 {
+    static const std::size_t key_size = ::boost::mpl::size<Placeholders>::value;
     const ::std::type_info * types[(::boost::mpl::size<Placeholders>::value)];
+    void copy_types(key_element* out) const
+    {
+        std::copy(types, types + key_size, out);
+    }
+    template<class Table, class Map>
+    const Table* get_converted_table() const
+    {
+        return ::boost::type_erasure::detail::get_converted_table<Table, Map>(*this);
+    }
     struct append_to_key
     {
-        append_to_key(const std::type_info * const * t, key_type* k) : types(t), key(k) {}
+        append_to_key(const std::type_info * const * t, key_element*& k) : types(t), key(&k) {}
         template<class P>
         void operator()(P)
         {
-            key->push_back(types[(::boost::mpl::index_of<Placeholders, P>::type::value)]);
+            *(*key)++ = types[(::boost::mpl::index_of<Placeholders, P>::type::value)];
         }
         const std::type_info * const * types;
-        key_type * key;
+        key_element ** key;
     };
     template<class F>
     typename F::type lookup(F*) const {
-        key_type key;
         typedef typename ::boost::type_erasure::detail::get_placeholders<F, ::boost::mpl::set0<> >::type placeholders;
         typedef typename ::boost::mpl::fold<
             placeholders,
             ::boost::mpl::map0<>,
             ::boost::type_erasure::detail::counting_map_appender
         >::type placeholder_map;
-        key.push_back(&typeid(typename ::boost::type_erasure::detail::rebind_placeholders<F, placeholder_map>::type));
-        ::boost::mpl::for_each<placeholders>(append_to_key(types, &key));
-        return reinterpret_cast<typename F::type>(lookup_function_impl(key));
+        key_element key[::boost::type_erasure::detail::key_size<placeholders>::value];
+        key_element* pos = key;
+        *pos++ = &typeid(typename ::boost::type_erasure::detail::rebind_placeholders<F, placeholder_map>::type);
+        ::boost::mpl::for_each<placeholders>(append_to_key(types, pos));
+        return reinterpret_cast<typename F::type>(find_function_impl(
+            key, ::boost::type_erasure::detail::key_size<placeholders>::value));
     }
     template<class Bindings>
     void init()
@@ -25,6 +25,7 @@
 #include <boost/type_erasure/is_placeholder.hpp>
 #include <boost/type_erasure/concept_of.hpp>
 #include <boost/type_erasure/config.hpp>
+#include <boost/type_erasure/detail/meta.hpp>
 
 namespace boost {
 namespace type_erasure {
@@ -0,0 +1,112 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#ifndef BOOST_TYPE_ERASURE_DETAIL_INTRUSIVE_STORAGE_HPP_INCLUDED
+#define BOOST_TYPE_ERASURE_DETAIL_INTRUSIVE_STORAGE_HPP_INCLUDED
+
+#include <cstddef>
+#include <new>
+#include <boost/config.hpp>
+#include <boost/atomic.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <boost/type_erasure/detail/storage.hpp>
+
+namespace boost {
+namespace type_erasure {
+namespace detail {
+
+// The reference count of a block shared by copy_on_write.
+template<bool Shared>
+struct intrusive_count
+{
+    intrusive_count() : count(1) {}
+    ::boost::atomic<std::size_t> count;
+};
+
+template<>
+struct intrusive_count<false> {};
+
+// The offset of an object from the start of its block.
+template<class Block>
+struct intrusive_object_offset
+{
+    BOOST_STATIC_CONSTANT(std::size_t, value =
+        (sizeof(Block) + sizeof(::boost::detail::max_align) - 1) /
+        sizeof(::boost::detail::max_align) * sizeof(::boost::detail::max_align));
+};
+
+// The heap block that an intrusive any points to.
+// An object constructed by the any follows the block
+// in the same allocation.  Other objects, such as the
+// result of call, are allocated on their own and only
+// referred to by data.
+template<class Table, bool Shared = false>
+struct intrusive_block : intrusive_count<Shared>
+{
+    // The block of an empty any.
+    intrusive_block() { data.data = 0; }
+    intrusive_block(const Table& table_arg, const storage& data_arg)
+      : table(table_arg), data(data_arg) {}
+    Table table;
+    storage data;
+
+    void* object_address();
+    bool holds_object_inline()
+    { return data.data == object_address(); }
+};
+
+template<class Table, bool Shared>
+void* intrusive_block<Table, Shared>::object_address()
+{
+    return reinterpret_cast<char*>(this) +
+        intrusive_object_offset<intrusive_block>::value;
+}
+
+// Allocates the memory for an object together with an
+// intrusive_block.  space() describes the memory to
+// storage_allocation and the vtable, which remain
+// unaware of the block.  Afterwards, block is the start
+// of the allocation, or null if the object was created
+// with new because it is over-aligned.
+template<class Block>
+struct intrusive_allocation
+{
+    intrusive_allocation() : block(0) {}
+    storage_space space()
+    { return storage_space(0, 0, 0, this, &functions); }
+    // The space to destroy an object that is inline in a block.
+    static storage_space data_space()
+    { return storage_space(0, 0, 0, 0, &functions); }
+    static void* allocate(void* self, std::size_t size)
+    {
+        void* result = ::operator new(intrusive_object_offset<Block>::value + size);
+        static_cast<intrusive_allocation*>(self)->block = result;
+        return static_cast<char*>(result) + intrusive_object_offset<Block>::value;
+    }
+    static void deallocate(void*, void* p, std::size_t)
+    {
+        ::operator delete(static_cast<char*>(p) - intrusive_object_offset<Block>::value);
+    }
+    static const storage_allocator functions;
+    void* block;
+};
+
+template<class Block>
+const storage_allocator intrusive_allocation<Block>::functions = {
+    &intrusive_allocation<Block>::allocate,
+    &intrusive_allocation<Block>::deallocate
+};
+
+}
+}
+}
+
+#endif
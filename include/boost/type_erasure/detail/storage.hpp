@@ -11,12 +11,29 @@
 #ifndef BOOST_TYPE_ERASURE_DETAIL_STORAGE_HPP_INCLUDED
 #define BOOST_TYPE_ERASURE_DETAIL_STORAGE_HPP_INCLUDED
 
+#include <cstddef>
+#include <cstring>
+#include <new>
 #include <boost/config.hpp>
+#include <boost/assert.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/utility/enable_if.hpp>
 #include <boost/type_traits/remove_reference.hpp>
 #include <boost/type_traits/decay.hpp>
+#include <boost/type_traits/is_base_and_derived.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/is_nothrow_move_constructible.hpp>
+#include <boost/type_traits/is_trivially_copyable.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <boost/type_erasure/detail/type_token.hpp>
 
 #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
 #   include <utility> // for std::forward, std::move
+#   include <memory> // for std::allocator_traits, std::allocator_arg_t
+#   include <type_traits> // for std::is_nothrow_constructible
 #endif
 
 #ifdef BOOST_MSVC
@@ -32,10 +49,20 @@ struct storage
 {
     storage() {}
 #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    // Defaulted, so that storage and the reference versions
+    // of any stay trivially copyable.  storage(storage&)
+    // keeps the constructor below from taking non-const lvalues.
+#ifndef BOOST_NO_CXX11_DEFAULTED_FUNCTIONS
+    storage(storage& other) = default;
+    storage(const storage& other) = default;
+    storage(storage&& other) = default;
+    storage& operator=(const storage& other) = default;
+#else
     storage(storage& other) : data(other.data) {}
     storage(const storage& other) : data(other.data) {}
     storage(storage&& other) : data(other.data) {}
     storage& operator=(const storage& other) { data = other.data; return *this; }
+#endif
     template<class T>
     explicit storage(T&& arg) : data(new typename boost::decay<T>::type(std::forward<T>(arg))) {}
 #else
@@ -45,6 +72,512 @@ struct storage
     void* data;
 };
 
+// The allocation functions of an allocator, with the
+// allocator type erased, so that the vtable does not
+// depend on it.  Sizes are in bytes.
+struct storage_allocator
+{
+    void* (*allocate)(void* alloc, std::size_t size);
+    void (*deallocate)(void* alloc, void* p, std::size_t size);
+};
+
+/**
+ * Describes where a @c managed_storage can put an object:
+ * an inline buffer of @c size bytes aligned to @c align
+ * at @c address, and an allocator for objects that do
+ * not fit.  A default constructed @c storage_space has
+ * neither, which forces all objects onto the heap.
+ *
+ * If @c replace is not null, it points to an object of
+ * the type being created that no one else refers to.
+ * The result of a call may take its place instead of
+ * being created in the space.
+ */
+struct storage_space
+{
+    storage_space()
+      : address(0), size(0), align(0), allocator(0), allocator_ops(0), replace(0) {}
+    storage_space(void* address_arg, std::size_t size_arg, std::size_t align_arg,
+        void* allocator_arg = 0, const storage_allocator* allocator_ops_arg = 0)
+      : address(address_arg), size(size_arg), align(align_arg),
+        allocator(allocator_arg), allocator_ops(allocator_ops_arg), replace(0) {}
+    void* address;
+    std::size_t size;
+    std::size_t align;
+    void* allocator;
+    const storage_allocator* allocator_ops;
+    void* replace;
+};
+
+// Objects are only placed in a buffer if they can be moved
+// out of it without throwing, so that swapping two anys
+// can never fail.
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+template<class T>
+struct can_store_in_buffer : ::boost::is_nothrow_move_constructible<T> {};
+#else
+template<class T>
+struct can_store_in_buffer : ::boost::mpl::false_ {};
+#endif
+
+template<class T>
+bool fits_in_buffer(const storage_space& space)
+{
+    return ::boost::type_erasure::detail::can_store_in_buffer<T>::value &&
+        sizeof(T) <= space.size &&
+        ::boost::alignment_of<T>::value <= space.align;
+}
+
+// The allocator only hands out memory aligned for
+// max_align.  Anything stricter goes to operator new.
+template<class T>
+bool uses_allocator(const storage_space& space)
+{
+    return space.allocator_ops != 0 &&
+        ::boost::alignment_of<T>::value <=
+            ::boost::alignment_of< ::boost::detail::max_align>::value;
+}
+
+inline bool is_in_buffer(const storage& arg, const storage_space& space)
+{
+    return space.address != 0 && arg.data == space.address;
+}
+
+/**
+ * What a binding records about the type that it was
+ * created for, so that @c any can copy, relocate and
+ * destroy objects of a @c trivial type with @c memcpy
+ * instead of calling through the vtable.  @c type
+ * identifies the type, so that @c any can tell whether
+ * it already holds an object of a given type.  A binding
+ * that does not know its type, such as one converted
+ * from a @c dynamic_binding, reports a type that is
+ * not @c trivial and has a null @c type.
+ */
+struct object_traits
+{
+    std::size_t size;
+    std::size_t align;
+    bool trivial;
+    ::boost::type_erasure::detail::type_token type;
+};
+
+template<class T>
+struct is_trivial_object :
+    ::boost::mpl::bool_<
+        ::boost::is_trivially_copyable<T>::value &&
+        ::boost::has_trivial_destructor<T>::value &&
+        ::boost::type_erasure::detail::can_store_in_buffer<T>::value
+    >
+{};
+
+template<class T>
+struct object_traits_of
+{
+    static const object_traits value;
+};
+
+template<class T>
+const object_traits object_traits_of<T>::value = {
+    sizeof(T),
+    ::boost::alignment_of<T>::value,
+    ::boost::type_erasure::detail::is_trivial_object<T>::value,
+    {
+        &typeid(T),
+        &::boost::type_erasure::detail::type_hash<T>::value
+    }
+};
+
+/**
+ * Reserves memory for a @c T in @c space.  @c address is
+ * null if the object should be created with plain @c new.
+ * Memory taken from the allocator is given back when the
+ * @c storage_allocation is destroyed, unless @c release was
+ * called after the object was constructed successfully.
+ */
+template<class T>
+class storage_allocation
+{
+public:
+    explicit storage_allocation(const storage_space& space)
+      : _space(space), _address(0), _owned(false)
+    {
+        if(::boost::type_erasure::detail::fits_in_buffer<T>(space)) {
+            _address = space.address;
+        } else if(::boost::type_erasure::detail::uses_allocator<T>(space)) {
+            _address = space.allocator_ops->allocate(space.allocator, sizeof(T));
+            _owned = true;
+        }
+    }
+    ~storage_allocation()
+    {
+        if(_owned) {
+            _space.allocator_ops->deallocate(_space.allocator, _address, sizeof(T));
+        }
+    }
+    void* address() const { return _address; }
+    void release() { _owned = false; }
+private:
+    storage_allocation(const storage_allocation&);
+    storage_allocation& operator=(const storage_allocation&);
+    storage_space _space;
+    void* _address;
+    bool _owned;
+};
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+
+template<class T>
+void relocate_from_buffer(storage& arg, storage& dest, void* dest_buffer, ::boost::mpl::true_)
+{
+    BOOST_ASSERT(dest_buffer != 0);
+    T* p = static_cast<T*>(arg.data);
+    dest.data = ::new (dest_buffer) T(std::move(*p));
+    p->~T();
+}
+
+#endif
+
+template<class T>
+void relocate_from_buffer(storage&, storage&, void*, ::boost::mpl::false_)
+{
+    BOOST_ASSERT(!"only types that satisfy can_store_in_buffer are stored inline");
+}
+
+/**
+ * Destroys the object held by @c arg, or, if @c dest is
+ * not null, transfers ownership of it to @c dest.  @c space
+ * and @c dest_space describe where @c arg and @c dest keep
+ * their objects.  An object that lives in a buffer is moved
+ * into the buffer of @c dest; a heap allocated object just
+ * changes hands, and the owner of @c dest must take over
+ * the allocator that it came from.
+ */
+template<class T>
+void manage_storage(storage& arg, const storage_space& space,
+    storage* dest, const storage_space& dest_space)
+{
+    if(dest == 0) {
+        if(::boost::type_erasure::detail::is_in_buffer(arg, space)) {
+            static_cast<T*>(arg.data)->~T();
+        } else if(::boost::type_erasure::detail::uses_allocator<T>(space)) {
+            static_cast<T*>(arg.data)->~T();
+            space.allocator_ops->deallocate(space.allocator, arg.data, sizeof(T));
+        } else {
+            delete static_cast<T*>(arg.data);
+        }
+    } else {
+        if(::boost::type_erasure::detail::is_in_buffer(arg, space)) {
+            ::boost::type_erasure::detail::relocate_from_buffer<T>(
+                arg, *dest, dest_space.address,
+                ::boost::type_erasure::detail::can_store_in_buffer<T>());
+        } else {
+            dest->data = arg.data;
+        }
+    }
+}
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+
+// Adapts an allocator to storage_allocator.  Memory is
+// requested in units of max_align, so that it is suitably
+// aligned for any type that uses_allocator accepts.
+template<class Alloc>
+struct allocator_functions
+{
+    typedef typename ::std::allocator_traits<Alloc>::template
+        rebind_alloc< ::boost::detail::max_align> allocator_type;
+    typedef ::std::allocator_traits<allocator_type> traits;
+    static std::size_t units(std::size_t size)
+    {
+        return (size + sizeof(::boost::detail::max_align) - 1) /
+            sizeof(::boost::detail::max_align);
+    }
+    static void* allocate(void* alloc, std::size_t size)
+    {
+        return ::std::addressof(*traits::allocate(
+            *static_cast<allocator_type*>(alloc), units(size)));
+    }
+    static void deallocate(void* alloc, void* p, std::size_t size)
+    {
+        traits::deallocate(
+            *static_cast<allocator_type*>(alloc),
+            ::std::pointer_traits<typename traits::pointer>::pointer_to(
+                *static_cast< ::boost::detail::max_align*>(p)),
+            units(size));
+    }
+    static const storage_allocator value;
+};
+
+template<class Alloc>
+const storage_allocator allocator_functions<Alloc>::value = {
+    &allocator_functions<Alloc>::allocate,
+    &allocator_functions<Alloc>::deallocate
+};
+
+template<std::size_t Size, std::size_t Align>
+struct storage_buffer_holder
+{
+    void* buffer_address() { return &_buffer; }
+    const void* buffer_address() const { return &_buffer; }
+    typename ::boost::aligned_storage<Size, Align>::type _buffer;
+};
+
+template<std::size_t Align>
+struct storage_buffer_holder<0, Align>
+{
+    void* buffer_address() { return 0; }
+    const void* buffer_address() const { return 0; }
+};
+
+// Holds the allocator of a managed_storage.  Heap objects
+// that a managed_storage adopts were created by new rather
+// than by its allocator, so it also remembers whether the
+// allocator owns the current object.
+template<class Alloc>
+struct storage_allocator_holder
+{
+    typedef typename ::boost::type_erasure::detail::allocator_functions<Alloc>::allocator_type allocator_type;
+    storage_allocator_holder() : _owns_data(false) {}
+    template<class A>
+    explicit storage_allocator_holder(const A& alloc) : _allocator(alloc), _owns_data(false) {}
+    void* allocator_address() { return &_allocator; }
+    const storage_allocator* allocator_ops()
+    { return &::boost::type_erasure::detail::allocator_functions<Alloc>::value; }
+    const storage_allocator* data_allocator_ops()
+    { return _owns_data? allocator_ops() : 0; }
+    void set_owns_data(bool value) { _owns_data = value; }
+    // Allocators are CopyConstructible, but need not be assignable.
+    void assign_allocator(const storage_allocator_holder& other)
+    {
+        _allocator.~allocator_type();
+        ::new (static_cast<void*>(&_allocator)) allocator_type(other._allocator);
+        _owns_data = other._owns_data;
+    }
+    void swap_allocator(storage_allocator_holder& other)
+    {
+        storage_allocator_holder tmp(_allocator);
+        tmp._owns_data = _owns_data;
+        assign_allocator(other);
+        other.assign_allocator(tmp);
+    }
+    allocator_type _allocator;
+    bool _owns_data;
+};
+
+template<>
+struct storage_allocator_holder<void>
+{
+    void* allocator_address() { return 0; }
+    const storage_allocator* allocator_ops() { return 0; }
+    const storage_allocator* data_allocator_ops() { return 0; }
+    void set_owns_data(bool) {}
+    void assign_allocator(const storage_allocator_holder&) {}
+    void swap_allocator(storage_allocator_holder&) {}
+};
+
+/**
+ * Storage with an inline buffer of @c Size bytes aligned
+ * to @c Align, which allocates objects that do not fit with
+ * @c Alloc.  @c Size may be 0 and @c Alloc may be void, if
+ * there is no buffer or allocator.  @c data always points
+ * to the held object, wherever it lives, so a
+ * @c managed_storage can be used anywhere that a
+ * @c storage is expected.
+ *
+ * A @c managed_storage must not be copied, since that would
+ * alias the buffer.  Its owner copies, moves and destroys it
+ * through the vtable instead.
+ */
+template<std::size_t Size, std::size_t Align, class Alloc>
+struct managed_storage :
+    storage,
+    ::boost::type_erasure::detail::storage_buffer_holder<Size, Align>,
+    ::boost::type_erasure::detail::storage_allocator_holder<Alloc>
+{
+    typedef ::boost::type_erasure::detail::storage_allocator_holder<Alloc> allocator_holder;
+    managed_storage() {}
+    // adopt a heap allocated object
+    managed_storage(storage& other) : storage(other) {}
+    managed_storage(const storage& other) : storage(other) {}
+    managed_storage(storage&& other) : storage(other) {}
+    template<class T,
+        typename ::boost::disable_if_c<
+            ::boost::is_same<typename ::boost::decay<T>::type, storage>::value ||
+            ::boost::is_base_and_derived<storage, typename ::boost::decay<T>::type>::value
+        >::type* = nullptr
+    >
+    explicit managed_storage(T&& arg)
+    {
+        construct(std::forward<T>(arg));
+    }
+    template<class A, class T>
+    managed_storage(::std::allocator_arg_t, const A& alloc, T&& arg)
+      : allocator_holder(alloc)
+    {
+        construct(std::forward<T>(arg));
+    }
+    managed_storage(const managed_storage&) = delete;
+    managed_storage& operator=(const managed_storage&) = delete;
+    // take an object that was constructed in space()
+    managed_storage& operator=(const storage& other)
+    {
+        data = other.data;
+        this->set_owns_data(true);
+        return *this;
+    }
+    storage_space space()
+    {
+        return storage_space(this->buffer_address(), Size, Align,
+            this->allocator_address(), this->allocator_ops());
+    }
+    // the space that the current object was constructed in
+    storage_space data_space()
+    {
+        return storage_space(this->buffer_address(), Size, Align,
+            this->allocator_address(), this->data_allocator_ops());
+    }
+private:
+    template<class T>
+    void construct(T&& arg)
+    {
+        typedef typename ::boost::decay<T>::type value_type;
+        ::boost::type_erasure::detail::storage_allocation<value_type> memory(space());
+        data = memory.address()?
+            ::new (memory.address()) value_type(std::forward<T>(arg)) :
+            new value_type(std::forward<T>(arg));
+        memory.release();
+        this->set_owns_data(true);
+    }
+};
+
+template<std::size_t Size, std::size_t Align, class Alloc>
+storage_space get_space(managed_storage<Size, Align, Alloc>& arg) { return arg.space(); }
+template<std::size_t Size, std::size_t Align, class Alloc>
+storage_space get_data_space(managed_storage<Size, Align, Alloc>& arg) { return arg.data_space(); }
+
+// The allocator goes along with the object when an
+// any is copied or moved.
+template<std::size_t Size, std::size_t Align, class Alloc>
+void copy_allocator(managed_storage<Size, Align, Alloc>& dest,
+    const managed_storage<Size, Align, Alloc>& src)
+{
+    dest.assign_allocator(src);
+    dest.set_owns_data(false);
+}
+template<std::size_t Size, std::size_t Align, class Alloc>
+void take_allocator(managed_storage<Size, Align, Alloc>& dest,
+    managed_storage<Size, Align, Alloc>& src)
+{
+    dest.assign_allocator(src);
+    src.set_owns_data(false);
+}
+
+#ifndef BOOST_NO_CXX11_VARIADIC_TEMPLATES
+
+// Creates a T from arg... in space.
+template<class T, class... A>
+storage construct_value(const storage_space& space, A&&... arg)
+{
+    ::boost::type_erasure::detail::storage_allocation<T> memory(space);
+    storage result;
+    result.data = memory.address()?
+        ::new (memory.address()) T(std::forward<A>(arg)...) :
+        new T(std::forward<A>(arg)...);
+    memory.release();
+    return result;
+}
+
+// An object can be replaced in its own memory if that
+// cannot fail after the old one is destroyed.
+template<class T, class... A>
+struct can_reconstruct :
+    ::boost::mpl::bool_<
+        ::std::is_nothrow_constructible<T, A&&...>::value ||
+        ::boost::is_nothrow_move_constructible<T>::value
+    >
+{};
+
+template<class T, class... A>
+T* reconstruct_impl(T* p, ::boost::mpl::true_, A&&... arg)
+{
+    p->~T();
+    return ::new (static_cast<void*>(p)) T(std::forward<A>(arg)...);
+}
+
+template<class T, class... A>
+T* reconstruct_impl(T* p, ::boost::mpl::false_, A&&... arg)
+{
+    T temp(std::forward<A>(arg)...);
+    p->~T();
+    return ::new (static_cast<void*>(p)) T(std::move(temp));
+}
+
+// Replaces the T at p with a T created from arg...
+// Requires can_reconstruct<T, A...>.
+template<class T, class... A>
+T* reconstruct(void* p, A&&... arg)
+{
+    return ::boost::type_erasure::detail::reconstruct_impl(static_cast<T*>(p),
+        ::boost::mpl::bool_< ::std::is_nothrow_constructible<T, A&&...>::value>(),
+        std::forward<A>(arg)...);
+}
+
+#endif
+
+// Shortcuts for trivial objects, which skip the vtable.
+// They return false if the vtable must be called instead.
+
+// Copies an object into the buffer of dest, if it fits.
+template<std::size_t Size, std::size_t Align, class Alloc>
+bool copy_trivial(managed_storage<Size, Align, Alloc>& dest,
+    const managed_storage<Size, Align, Alloc>& src, const object_traits& traits)
+{
+    if(Size == 0 || !traits.trivial || traits.size > Size || traits.align > Align) {
+        return false;
+    }
+    std::memcpy(dest.buffer_address(), src.data, traits.size);
+    dest.data = dest.buffer_address();
+    return true;
+}
+// Only objects in the buffer can be dropped without
+// releasing their memory.
+template<std::size_t Size, std::size_t Align, class Alloc>
+bool destroy_trivial(managed_storage<Size, Align, Alloc>& arg, const object_traits& traits)
+{
+    return traits.trivial && Size != 0 && arg.data == arg.buffer_address();
+}
+// Heap objects always just change hands.
+template<std::size_t Size, std::size_t Align, class Alloc1, class Alloc2>
+bool relocate_trivial(managed_storage<Size, Align, Alloc1>& dest,
+    managed_storage<Size, Align, Alloc2>& src, const object_traits& traits)
+{
+    if(Size == 0 || src.data != src.buffer_address()) {
+        dest.data = src.data;
+        return true;
+    } else if(traits.trivial) {
+        std::memcpy(dest.buffer_address(), src.data, traits.size);
+        dest.data = dest.buffer_address();
+        return true;
+    } else {
+        return false;
+    }
+}
+
+#endif
+
+inline storage_space get_space(storage&) { return storage_space(); }
+inline storage_space get_data_space(storage&) { return storage_space(); }
+inline void copy_allocator(storage&, const storage&) {}
+inline void take_allocator(storage&, storage&) {}
+inline bool copy_trivial(storage&, const storage&, const object_traits&) { return false; }
+inline bool destroy_trivial(storage&, const object_traits&) { return false; }
+inline bool relocate_trivial(storage& dest, storage& src, const object_traits&)
+{
+    dest.data = src.data;
+    return true;
+}
+
 
 #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
 
@@ -0,0 +1,200 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#ifndef BOOST_TYPE_ERASURE_DETAIL_STORAGE_OF_HPP_INCLUDED
+#define BOOST_TYPE_ERASURE_DETAIL_STORAGE_OF_HPP_INCLUDED
+
+#include <cstddef>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/identity.hpp>
+#include <boost/mpl/eval_if.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/mpl/fold.hpp>
+#include <boost/mpl/placeholders.hpp>
+#include <boost/mpl/is_sequence.hpp>
+#include <boost/mpl/not.hpp>
+#include <boost/mpl/or.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_erasure/detail/access.hpp>
+#include <boost/type_erasure/detail/storage.hpp>
+#include <boost/type_erasure/small_buffer.hpp>
+#include <boost/type_erasure/with_allocator.hpp>
+#include <boost/type_erasure/intrusive.hpp>
+#include <boost/type_erasure/copy_on_write.hpp>
+
+namespace boost {
+namespace type_erasure {
+namespace detail {
+
+// Metafunction classes that recognize the special
+// concepts which control storage.  apply returns
+// void for anything else.
+struct match_small_buffer
+{
+    template<class T>
+    struct apply { typedef void type; };
+};
+
+template<std::size_t Size, std::size_t Align>
+struct match_small_buffer::apply< ::boost::type_erasure::small_buffer<Size, Align> >
+{
+    typedef ::boost::type_erasure::small_buffer<Size, Align> type;
+};
+
+struct match_allocator
+{
+    template<class T>
+    struct apply { typedef void type; };
+};
+
+template<class Alloc>
+struct match_allocator::apply< ::boost::type_erasure::with_allocator<Alloc> >
+{
+    typedef Alloc type;
+};
+
+struct match_intrusive
+{
+    template<class T>
+    struct apply { typedef void type; };
+};
+
+template<>
+struct match_intrusive::apply< ::boost::type_erasure::intrusive>
+{
+    typedef ::boost::type_erasure::intrusive type;
+};
+
+struct match_copy_on_write
+{
+    template<class T>
+    struct apply { typedef void type; };
+};
+
+template<>
+struct match_copy_on_write::apply< ::boost::type_erasure::copy_on_write>
+{
+    typedef ::boost::type_erasure::copy_on_write type;
+};
+
+template<class Concept, class Match>
+struct find_storage_option;
+
+template<class Concept, class Match>
+struct find_storage_option_impl :
+    ::boost::mpl::fold<
+        Concept,
+        void,
+        ::boost::mpl::if_<
+            ::boost::is_same< ::boost::mpl::_1, void>,
+            ::boost::type_erasure::detail::find_storage_option< ::boost::mpl::_2, Match>,
+            ::boost::mpl::_1
+        >
+    >
+{};
+
+// Returns the first match in Concept or void if there is none.
+// The special concepts are themselves empty sequences, so they
+// have to be checked before recursing.
+template<class Concept, class Match>
+struct find_storage_option :
+    ::boost::mpl::eval_if<
+        ::boost::is_same<typename Match::template apply<Concept>::type, void>,
+        ::boost::mpl::eval_if< ::boost::mpl::is_sequence<Concept>,
+            ::boost::type_erasure::detail::find_storage_option_impl<Concept, Match>,
+            ::boost::mpl::identity<void>
+        >,
+        typename Match::template apply<Concept>
+    >
+{};
+
+template<class SmallBuffer, class Alloc>
+struct make_storage
+{
+    typedef ::boost::type_erasure::detail::storage type;
+};
+
+#ifdef BOOST_TYPE_ERASURE_SFINAE_FRIENDLY_CONSTRUCTORS
+
+template<std::size_t Size, std::size_t Align, class Alloc>
+struct make_storage< ::boost::type_erasure::small_buffer<Size, Align>, Alloc>
+{
+    typedef ::boost::type_erasure::detail::managed_storage<Size, Align, Alloc> type;
+};
+
+template<class Alloc>
+struct make_storage<void, Alloc>
+{
+    typedef ::boost::type_erasure::detail::managed_storage<0, 1, Alloc> type;
+};
+
+template<>
+struct make_storage<void, void>
+{
+    typedef ::boost::type_erasure::detail::storage type;
+};
+
+#endif
+
+// The storage used by a value any with Concept.
+template<class Concept>
+struct storage_of :
+    ::boost::type_erasure::detail::make_storage<
+        typename ::boost::type_erasure::detail::find_storage_option<
+            Concept, ::boost::type_erasure::detail::match_small_buffer>::type,
+        typename ::boost::type_erasure::detail::find_storage_option<
+            Concept, ::boost::type_erasure::detail::match_allocator>::type
+    >
+{};
+
+template<class Concept>
+struct has_allocator :
+    ::boost::mpl::not_< ::boost::is_same<
+        typename ::boost::type_erasure::detail::find_storage_option<
+            Concept, ::boost::type_erasure::detail::match_allocator>::type,
+        void
+    > >
+{};
+
+// intrusive and copy_on_write need the SFINAE friendly
+// constructors of any.  copy_on_write uses the layout of
+// intrusive.
+#ifdef BOOST_TYPE_ERASURE_SFINAE_FRIENDLY_CONSTRUCTORS
+template<class Concept>
+struct is_copy_on_write :
+    ::boost::mpl::not_< ::boost::is_same<
+        typename ::boost::type_erasure::detail::find_storage_option<
+            Concept, ::boost::type_erasure::detail::match_copy_on_write>::type,
+        void
+    > >
+{};
+template<class Concept>
+struct is_intrusive :
+    ::boost::mpl::or_<
+        ::boost::mpl::not_< ::boost::is_same<
+            typename ::boost::type_erasure::detail::find_storage_option<
+                Concept, ::boost::type_erasure::detail::match_intrusive>::type,
+            void
+        > >,
+        ::boost::type_erasure::detail::is_copy_on_write<Concept>
+    >
+{};
+#else
+template<class Concept>
+struct is_copy_on_write : ::boost::mpl::false_ {};
+template<class Concept>
+struct is_intrusive : ::boost::mpl::false_ {};
+#endif
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,130 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#ifndef BOOST_TYPE_ERASURE_DETAIL_TYPE_TOKEN_HPP_INCLUDED
+#define BOOST_TYPE_ERASURE_DETAIL_TYPE_TOKEN_HPP_INCLUDED
+
+#include <cstddef>
+#include <typeinfo>
+#include <boost/type_traits/remove_cv.hpp>
+#include <boost/type_traits/remove_reference.hpp>
+
+namespace boost {
+namespace type_erasure {
+
+template<class T>
+struct typeid_;
+
+namespace detail {
+
+// Identifies a type without calling through the vtable.
+// The same type may have several type_info objects when
+// it is used in more than one shared library, and
+// comparing them can mean comparing their names.  The
+// hash of the name settles most comparisons of different
+// types with a single compare.  It is 0 until it has been
+// computed during dynamic initialization.
+struct type_token
+{
+    const std::type_info* type;
+    const std::size_t* hash;
+};
+
+// FNV-1a, with the low bit set so that the result is never 0.
+inline std::size_t hash_type_name(const char* name)
+{
+    std::size_t result = 2166136261u;
+    for(; *name; ++name) {
+        result = (result ^ static_cast<unsigned char>(*name)) * 16777619u;
+    }
+    return result | 1u;
+}
+
+template<class T>
+struct type_hash
+{
+    static std::size_t value;
+};
+
+template<class T>
+std::size_t type_hash<T>::value =
+    ::boost::type_erasure::detail::hash_type_name(typeid(T).name());
+
+template<class T>
+struct type_token_of
+{
+    static const type_token value;
+};
+
+template<class T>
+const type_token type_token_of<T>::value = {
+    &typeid(T),
+    &::boost::type_erasure::detail::type_hash<T>::value
+};
+
+inline bool same_type(const type_token& lhs, const type_token& rhs)
+{
+    if(lhs.type == rhs.type) {
+        return true;
+    }
+    std::size_t lhs_hash = *lhs.hash;
+    std::size_t rhs_hash = *rhs.hash;
+    if(lhs_hash != rhs_hash && lhs_hash != 0 && rhs_hash != 0) {
+        return false;
+    }
+    return *lhs.type == *rhs.type;
+}
+
+// The functions below read the type that a binding maps
+// the placeholder P to.  They only call typeid_ through
+// the vtable when the binding has no type_token, as
+// happens when it was converted from a dynamic_binding.
+
+template<class P, class Binding>
+const std::type_info& bound_type(const Binding& table)
+{
+    const type_token& token = table.template find_type_token<P>();
+    if(token.type != 0) {
+        return *token.type;
+    }
+    return table.template find< ::boost::type_erasure::typeid_<P> >()();
+}
+
+template<class P, class T, class Binding>
+bool is_bound_to(const Binding& table)
+{
+    typedef typename ::boost::remove_cv<
+        typename ::boost::remove_reference<T>::type
+    >::type type;
+    const type_token& token = table.template find_type_token<P>();
+    if(token.type != 0) {
+        return ::boost::type_erasure::detail::same_type(
+            token, ::boost::type_erasure::detail::type_token_of<type>::value);
+    }
+    return table.template find< ::boost::type_erasure::typeid_<P> >()() == typeid(type);
+}
+
+template<class P, class Binding>
+bool same_bound_type(const Binding& lhs, const Binding& rhs)
+{
+    const type_token& lhs_token = lhs.template find_type_token<P>();
+    const type_token& rhs_token = rhs.template find_type_token<P>();
+    if(lhs_token.type != 0 && rhs_token.type != 0) {
+        return ::boost::type_erasure::detail::same_type(lhs_token, rhs_token);
+    }
+    return ::boost::type_erasure::detail::bound_type<P>(lhs) ==
+        ::boost::type_erasure::detail::bound_type<P>(rhs);
+}
+
+}
+}
+}
+
+#endif
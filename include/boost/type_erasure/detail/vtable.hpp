@@ -25,12 +25,68 @@
 #include <boost/preprocessor/repetition/enum_trailing_params.hpp>
 #include <boost/preprocessor/repetition/repeat.hpp>
 #include <boost/type_erasure/detail/rebind_placeholders.hpp>
+#include <boost/type_erasure/detail/storage.hpp>
+#include <boost/type_erasure/detail/type_token.hpp>
 #include <boost/type_erasure/config.hpp>
 
 namespace boost {
 namespace type_erasure {
+
+template<class T>
+struct destructible;
+
+template<class T>
+struct typeid_;
+
 namespace detail {
 
+// Some vtable entries also point to information about
+// the type, which lets any and any_cast bypass the
+// vtable.  vtable_info gives its type, or void if there
+// is none.  A table that is built from bare functions,
+// such as one converted from a dynamic_binding, holds
+// unknown_vtable_info instead.
+template<class T>
+struct vtable_info
+{
+    typedef void type;
+};
+
+template<class T>
+struct vtable_info< ::boost::type_erasure::destructible<T> >
+{
+    typedef ::boost::type_erasure::detail::object_traits type;
+};
+
+template<class T>
+struct vtable_info< ::boost::type_erasure::typeid_<T> >
+{
+    typedef ::boost::type_erasure::detail::type_token type;
+};
+
+// The information for a concept applied to actual types.
+template<class T>
+struct vtable_info_of;
+
+template<class T>
+struct vtable_info_of< ::boost::type_erasure::destructible<T> > :
+    ::boost::type_erasure::detail::object_traits_of<T>
+{};
+
+template<class T>
+struct vtable_info_of< ::boost::type_erasure::typeid_<T> > :
+    ::boost::type_erasure::detail::type_token_of<T>
+{};
+
+template<class Info>
+struct unknown_vtable_info
+{
+    static const Info value;
+};
+
+template<class Info>
+const Info unknown_vtable_info<Info>::value = Info();
+
 #if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_CONSTEXPR) && !defined(BOOST_NO_CXX11_DEFAULTED_FUNCTIONS)
 
 template<class... T>
@@ -85,14 +141,78 @@ struct make_vtable_init
     >::type type;
 };
 
-template<class T>
+template<class F, class Info>
+struct vtable_entry_init
+{
+    constexpr vtable_entry_init(F f)
+      : value(f),
+        info(&::boost::type_erasure::detail::unknown_vtable_info<Info>::value) {}
+    constexpr vtable_entry_init(F f, const Info* i)
+      : value(f), info(i) {}
+    F value;
+    const Info* info;
+};
+
+template<class T, class Info = typename ::boost::type_erasure::detail::vtable_info<T>::type>
 struct vtable_entry
 {
+    typedef ::boost::type_erasure::detail::vtable_entry_init<typename T::type, Info> init_type;
+    typename T::type value;
+    const Info* info;
+    vtable_entry() = default;
+    constexpr vtable_entry(init_type arg) : value(arg.value), info(arg.info) {}
+    init_type get() const { return init_type(value, info); }
+};
+
+template<class T>
+struct vtable_entry<T, void>
+{
+    typedef typename T::type init_type;
     typename T::type value;
     vtable_entry() = default;
     constexpr vtable_entry(typename T::type arg) : value(arg) {}
+    init_type get() const { return value; }
+};
+
+// Names the class whose static member value initializes
+// the entry for T in a vtable.
+template<class T, class Info = typename ::boost::type_erasure::detail::vtable_info<T>::type>
+struct vtable_entry_value
+{
+    typedef vtable_entry_value type;
+    static constexpr ::boost::type_erasure::detail::vtable_entry_init<typename T::type, Info> value =
+        ::boost::type_erasure::detail::vtable_entry_init<typename T::type, Info>(
+            &T::value, &::boost::type_erasure::detail::vtable_info_of<T>::value);
+};
+
+template<class T, class Info>
+constexpr ::boost::type_erasure::detail::vtable_entry_init<typename T::type, Info>
+vtable_entry_value<T, Info>::value;
+
+template<class T>
+struct vtable_entry_value<T, void>
+{
+    typedef T type;
 };
 
+template<class... T>
+struct vtable_storage;
+
+// Reads the entry for U from src when converting a vtable.
+// The information about the type survives a conversion
+// from another vtable_storage.
+template<class Src, class U>
+typename U::type lookup_vtable_entry(const Src& src, U* u)
+{
+    return src.lookup(u);
+}
+
+template<class... T, class U>
+typename vtable_entry<U>::init_type lookup_vtable_entry(const vtable_storage<T...>& src, U* u)
+{
+    return src.lookup_entry(u);
+}
+
 template<class... T>
 struct compare_vtable;
 
@@ -121,14 +241,14 @@ struct vtable_storage : vtable_entry<T>...
 {
     vtable_storage() = default;
 
-    constexpr vtable_storage(typename T::type... arg)
+    constexpr vtable_storage(typename vtable_entry<T>::init_type... arg)
         : vtable_entry<T>(arg)... {}
 
     template<class Bindings, class Src>
     void convert_from(const Src& src)
     {
         *this = vtable_storage(
-            src.lookup(
+            ::boost::type_erasure::detail::lookup_vtable_entry(src,
                 (typename ::boost::type_erasure::detail::rebind_placeholders<
                 T, Bindings
             >::type*)0)...);
@@ -142,6 +262,18 @@ struct vtable_storage : vtable_entry<T>...
     {
         return static_cast<const vtable_entry<U>*>(this)->value;
     }
+
+    template<class U>
+    typename vtable_entry<U>::init_type lookup_entry(U*) const
+    {
+        return static_cast<const vtable_entry<U>*>(this)->get();
+    }
+
+    template<class U>
+    const typename vtable_info<U>::type& lookup_info(U*) const
+    {
+        return *static_cast<const vtable_entry<U>*>(this)->info;
+    }
 };
 
 // Provide this specialization manually.
@@ -167,7 +299,7 @@ struct make_vtable_impl<stored_arg_pack<T...> >
 template<class Table, class... T>
 struct vtable_init
 {
-    static constexpr Table value = Table(T::value...);
+    static constexpr Table value = Table(vtable_entry_value<T>::type::value...);
 };
 
 template<class Table, class... T>
@@ -257,6 +389,10 @@ struct BOOST_PP_CAT(vtable_storage, N)
 
     bool operator==(const BOOST_PP_CAT(vtable_storage, N)& BOOST_PP_EXPR_IF(N, other)) const
     { return true BOOST_PP_REPEAT(N, BOOST_TYPE_ERASURE_VTABLE_COMPARE, ~); }
+
+    template<class U>
+    const typename vtable_info<U>::type& lookup_info(U*) const
+    { return ::boost::type_erasure::detail::unknown_vtable_info<typename vtable_info<U>::type>::value; }
 };
 
 template<>
@@ -11,6 +11,7 @@
 #ifndef BOOST_TYPE_ERASURE_DYNAMIC_ANY_CAST_HPP_INCLUDED
 #define BOOST_TYPE_ERASURE_DYNAMIC_ANY_CAST_HPP_INCLUDED
 
+#include <new>
 #include <boost/type_erasure/detail/normalize.hpp>
 #include <boost/type_erasure/binding_of.hpp>
 #include <boost/type_erasure/static_binding.hpp>
@@ -19,6 +20,7 @@
 #include <boost/type_erasure/placeholder_of.hpp>
 #include <boost/type_erasure/any.hpp>
 #include <boost/type_erasure/binding.hpp>
+#include <boost/optional/optional.hpp>
 #include <boost/mpl/vector.hpp>
 #include <boost/mpl/set.hpp>
 #include <boost/mpl/fold.hpp>
@@ -82,13 +84,9 @@ struct make_result_placeholder_map
     > type;
 };
 
-#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
-template<class R, class Any, class Map>
-R dynamic_any_cast_impl(Any&& arg, const static_binding<Map>& map)
-#else
-template<class R, class Any, class Map>
-R dynamic_any_cast_impl(Any& arg, const static_binding<Map>& map)
-#endif
+// The types involved in casting Any to R.
+template<class R, class Any>
+struct dynamic_any_cast_types
 {
     typedef typename ::boost::remove_const<typename ::boost::remove_reference<Any>::type>::type src_type;
     typedef typename ::boost::type_erasure::detail::normalize_concept<
@@ -111,17 +109,13 @@ R dynamic_any_cast_impl(Any& arg, const static_binding<Map>& map)
 #else
     typedef ::boost::type_erasure::detail::make_identity_placeholder_map<normalized> identity_map;
 #endif
-    ::boost::type_erasure::dynamic_binding<placeholders> my_binding(
-        ::boost::type_erasure::binding_of(arg),
-        ::boost::type_erasure::make_binding<identity_map>());
     typedef typename ::boost::remove_const<
         typename ::boost::remove_reference<
             typename ::boost::type_erasure::placeholder_of<R>::type
         >::type
     >::type result_placeholder;
-    ::boost::type_erasure::binding< typename ::boost::type_erasure::concept_of<R>::type> new_binding(
-        my_binding,
-        map);
+    typedef ::boost::type_erasure::binding<
+        typename ::boost::type_erasure::concept_of<R>::type> binding_type;
     typedef ::boost::type_erasure::any<
         typename ::boost::type_erasure::concept_of<R>::type,
         typename ::boost::type_erasure::detail::make_ref_placeholder<
@@ -134,10 +128,53 @@ R dynamic_any_cast_impl(Any& arg, const static_binding<Map>& map)
 #endif
         >::type
     > result_ref_type;
+};
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+template<class R, class Any, class Map>
+R dynamic_any_cast_impl(Any&& arg, const static_binding<Map>& map)
+#else
+template<class R, class Any, class Map>
+R dynamic_any_cast_impl(Any& arg, const static_binding<Map>& map)
+#endif
+{
+    typedef ::boost::type_erasure::detail::dynamic_any_cast_types<R, Any> types;
+    ::boost::type_erasure::dynamic_binding<typename types::placeholders> my_binding(
+        ::boost::type_erasure::binding_of(arg),
+        ::boost::type_erasure::make_binding<typename types::identity_map>());
+    typename types::binding_type new_binding(
+        my_binding,
+        map);
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    return typename types::result_ref_type(std::forward<Any>(arg), new_binding);
+#else
+    return typename types::result_ref_type(arg, new_binding);
+#endif
+}
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+template<class R, class Any, class Map>
+::boost::optional<R> try_dynamic_any_cast_impl(Any&& arg, const static_binding<Map>& map)
+#else
+template<class R, class Any, class Map>
+::boost::optional<R> try_dynamic_any_cast_impl(Any& arg, const static_binding<Map>& map)
+#endif
+{
+    typedef ::boost::type_erasure::detail::dynamic_any_cast_types<R, Any> types;
+    ::boost::type_erasure::dynamic_binding<typename types::placeholders> my_binding(
+        ::boost::type_erasure::binding_of(arg),
+        ::boost::type_erasure::make_binding<typename types::identity_map>());
+    typename types::binding_type new_binding(
+        my_binding,
+        map,
+        std::nothrow);
+    if(!new_binding._boost_type_erasure_is_valid()) {
+        return ::boost::none;
+    }
 #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
-    return result_ref_type(std::forward<Any>(arg), new_binding);
+    return ::boost::optional<R>(R(typename types::result_ref_type(std::forward<Any>(arg), new_binding)));
 #else
-    return result_ref_type(arg, new_binding);
+    return ::boost::optional<R>(R(typename types::result_ref_type(arg, new_binding)));
 #endif
 }
 
@@ -189,6 +226,28 @@ R dynamic_any_cast(Any&& arg);
 template<class R, class Any, class Map>
 R dynamic_any_cast(Any&& arg, const static_binding<Map>&);
 
+/**
+ * Attempts to downcast or crosscast an @ref any like
+ * \dynamic_any_cast, but returns an empty optional
+ * instead of throwing if the concepts used by R were
+ * not registered.  Failure does not allocate memory.
+ *
+ * \pre The preconditions of \dynamic_any_cast.
+ *
+ * \throws std::bad_alloc or whatever copying R throws.
+ *         Nothing, if the cast fails.
+ *
+ * \see is_registered
+ */
+template<class R, class Any>
+boost::optional<R> try_dynamic_any_cast(Any&& arg);
+
+/**
+ * \overload
+ */
+template<class R, class Any, class Map>
+boost::optional<R> try_dynamic_any_cast(Any&& arg, const static_binding<Map>&);
+
 #else
 
 template<class R, class Concept, class Tag>
@@ -234,6 +293,49 @@ R dynamic_any_cast(any<Concept, Tag>&& arg, const static_binding<Map>& map)
 }
 #endif
 
+template<class R, class Concept, class Tag>
+::boost::optional<R> try_dynamic_any_cast(const any<Concept, Tag>& arg)
+{
+    return ::boost::type_erasure::detail::try_dynamic_any_cast_impl<R>(arg,
+        ::boost::type_erasure::make_binding<typename ::boost::type_erasure::detail::make_result_placeholder_map<R, Tag>::type>());
+}
+
+template<class R, class Concept, class Tag>
+::boost::optional<R> try_dynamic_any_cast(any<Concept, Tag>& arg)
+{
+    return ::boost::type_erasure::detail::try_dynamic_any_cast_impl<R>(arg,
+        ::boost::type_erasure::make_binding<typename ::boost::type_erasure::detail::make_result_placeholder_map<R, Tag>::type>());
+}
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+template<class R, class Concept, class Tag>
+::boost::optional<R> try_dynamic_any_cast(any<Concept, Tag>&& arg)
+{
+    return ::boost::type_erasure::detail::try_dynamic_any_cast_impl<R>(::std::move(arg),
+        ::boost::type_erasure::make_binding<typename ::boost::type_erasure::detail::make_result_placeholder_map<R, Tag>::type>());
+}
+#endif
+
+template<class R, class Concept, class Tag, class Map>
+::boost::optional<R> try_dynamic_any_cast(const any<Concept, Tag>& arg, const static_binding<Map>& map)
+{
+    return ::boost::type_erasure::detail::try_dynamic_any_cast_impl<R>(arg, map);
+}
+
+template<class R, class Concept, class Tag, class Map>
+::boost::optional<R> try_dynamic_any_cast(any<Concept, Tag>& arg, const static_binding<Map>& map)
+{
+    return ::boost::type_erasure::detail::try_dynamic_any_cast_impl<R>(arg, map);
+}
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+template<class R, class Concept, class Tag, class Map>
+::boost::optional<R> try_dynamic_any_cast(any<Concept, Tag>&& arg, const static_binding<Map>& map)
+{
+    return ::boost::type_erasure::detail::try_dynamic_any_cast_impl<R>(::std::move(arg), map);
+}
+#endif
+
 #endif
 
 }
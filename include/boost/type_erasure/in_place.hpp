@@ -0,0 +1,58 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#ifndef BOOST_TYPE_ERASURE_IN_PLACE_HPP_INCLUDED
+#define BOOST_TYPE_ERASURE_IN_PLACE_HPP_INCLUDED
+
+#include <boost/config.hpp>
+#include <boost/mpl/bool.hpp>
+
+namespace boost {
+namespace type_erasure {
+
+/**
+ * A tag that selects the constructor of @ref any which
+ * creates an object of type @c T directly in the storage
+ * of the @ref any, from the remaining arguments.
+ *
+ * \code
+ * any<copy_constructible<> > x(in_place_type_t<std::string>(), 3, 'a');
+ * \endcode
+ *
+ * \see any::emplace
+ */
+template<class T>
+struct in_place_type_t
+{
+    explicit in_place_type_t() {}
+};
+
+namespace detail {
+
+template<class T>
+struct is_in_place_arg : ::boost::mpl::false_ {};
+
+template<class T>
+struct is_in_place_arg<in_place_type_t<T> > : ::boost::mpl::true_ {};
+template<class T>
+struct is_in_place_arg<in_place_type_t<T>&> : ::boost::mpl::true_ {};
+template<class T>
+struct is_in_place_arg<const in_place_type_t<T>&> : ::boost::mpl::true_ {};
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+template<class T>
+struct is_in_place_arg<in_place_type_t<T>&&> : ::boost::mpl::true_ {};
+#endif
+
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,50 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#ifndef BOOST_TYPE_ERASURE_INTRUSIVE_HPP_INCLUDED
+#define BOOST_TYPE_ERASURE_INTRUSIVE_HPP_INCLUDED
+
+#include <boost/mpl/vector.hpp>
+
+namespace boost {
+namespace type_erasure {
+
+/**
+ * This special concept makes a value @ref any a single
+ * pointer.  The @ref binding is stored on the heap, in
+ * the same block as the object, instead of in the
+ * @ref any itself.  This makes containers of @ref any
+ * "anys" smaller, at the cost of always allocating.
+ *
+ * \code
+ * typedef any<mpl::vector<copy_constructible<>, intrusive> > any_type;
+ * BOOST_STATIC_ASSERT(sizeof(any_type) == sizeof(void*));
+ * \endcode
+ *
+ * Objects whose alignment is greater than that of
+ * @c std::max_align_t, and the results of @ref call, are
+ * allocated separately from the block that holds the
+ * @ref binding.  Moving an @ref any with @ref relaxed, or
+ * swapping two @ref any "anys", only exchanges pointers.
+ *
+ * @ref intrusive replaces the storage of the @ref any, so
+ * @ref small_buffer and @ref with_allocator are ignored when
+ * it is present.  It has no effect on references.
+ *
+ * \note @ref intrusive is only supported when the compiler
+ * provides rvalue references, variadic templates and
+ * inheriting constructors.  Otherwise it is ignored.
+ */
+struct intrusive : ::boost::mpl::vector0<> {};
+
+}
+}
+
+#endif
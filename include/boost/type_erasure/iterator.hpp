@@ -11,11 +11,19 @@
 #ifndef BOOST_TYPE_ERASURE_ITERATOR_HPP_INCLUDED
 #define BOOST_TYPE_ERASURE_ITERATOR_HPP_INCLUDED
 
+#include <cstddef>
 #include <iterator>
+#include <string>
+#include <vector>
+#include <boost/config.hpp>
+#include <boost/core/addressof.hpp>
 #include <boost/mpl/vector.hpp>
+#include <boost/mpl/bool.hpp>
 #include <boost/mpl/if.hpp>
+#include <boost/mpl/or.hpp>
 #include <boost/iterator/iterator_adaptor.hpp>
 #include <boost/iterator/iterator_categories.hpp>
+#include <boost/type_traits/is_same.hpp>
 #include <boost/type_traits/remove_const.hpp>
 #include <boost/type_traits/remove_reference.hpp>
 #include <boost/type_erasure/operators.hpp>
@@ -23,6 +31,10 @@
 #include <boost/type_erasure/deduced.hpp>
 #include <boost/type_erasure/is_placeholder.hpp>
 
+#ifndef BOOST_NO_CXX11_HDR_ARRAY
+#include <array>
+#endif
+
 namespace boost {
 
 namespace type_erasure {
@@ -39,6 +51,141 @@ struct iterator_value_type_impl
     typedef typename ::std::iterator_traits<T>::value_type type;
 };
 
+template<class T, class V>
+struct is_vector_iterator :
+    ::boost::mpl::or_<
+        ::boost::is_same<T, typename ::std::vector<V>::iterator>,
+        ::boost::is_same<T, typename ::std::vector<V>::const_iterator>
+    >
+{};
+
+template<class T, class V>
+struct is_contiguous_class_iterator :
+    ::boost::type_erasure::detail::is_vector_iterator<T, V>
+{};
+
+// The iterators of vector<bool> are proxies.
+template<class T>
+struct is_contiguous_class_iterator<T, bool> : ::boost::mpl::false_ {};
+
+template<class T, class C>
+struct is_contiguous_string_iterator :
+    ::boost::mpl::or_<
+        ::boost::type_erasure::detail::is_vector_iterator<T, C>,
+        ::boost::is_same<T, typename ::std::basic_string<C>::iterator>,
+        ::boost::is_same<T, typename ::std::basic_string<C>::const_iterator>
+    >
+{};
+
+template<class T>
+struct is_contiguous_class_iterator<T, char> :
+    ::boost::type_erasure::detail::is_contiguous_string_iterator<T, char>
+{};
+
+template<class T>
+struct is_contiguous_class_iterator<T, wchar_t> :
+    ::boost::type_erasure::detail::is_contiguous_string_iterator<T, wchar_t>
+{};
+
+// Whether the elements that T points to are adjacent in
+// memory.  Without C++20 concepts, this only knows about
+// pointers and the iterators of std::vector and
+// std::basic_string.
+template<class T>
+struct is_contiguous_iterator :
+#if defined(__cpp_lib_concepts)
+    ::boost::mpl::bool_< ::std::contiguous_iterator<T> >
+#else
+    ::boost::type_erasure::detail::is_contiguous_class_iterator<
+        T, typename ::std::iterator_traits<T>::value_type>
+#endif
+{};
+
+template<class T>
+struct is_contiguous_iterator<T*> : ::boost::mpl::true_ {};
+
+template<class R, class T>
+const R* contiguous_address(const T& it, ::boost::mpl::true_)
+{
+    return ::boost::addressof(*it);
+}
+
+template<class R, class T>
+const R* contiguous_address(const T&, ::boost::mpl::false_)
+{
+    return 0;
+}
+
+struct no_contiguous_data
+{
+    template<class R, class T>
+    static const R* data(const T&, std::size_t& size)
+    {
+        size = 0;
+        return 0;
+    }
+};
+
+// The ranges whose data are contiguous.
+template<class T>
+struct contiguous_range_traits :
+    ::boost::type_erasure::detail::no_contiguous_data
+{};
+
+template<class V, class A>
+struct contiguous_range_traits< ::std::vector<V, A> >
+{
+    template<class R>
+    static const R* data(const ::std::vector<V, A>& range, std::size_t& size)
+    {
+        size = range.size();
+        return range.empty()? 0 : &range[0];
+    }
+};
+
+// vector<bool> is not contiguous.
+template<class A>
+struct contiguous_range_traits< ::std::vector<bool, A> > :
+    ::boost::type_erasure::detail::no_contiguous_data
+{};
+
+template<class C, class Tr, class A>
+struct contiguous_range_traits< ::std::basic_string<C, Tr, A> >
+{
+    template<class R>
+    static const R* data(const ::std::basic_string<C, Tr, A>& range, std::size_t& size)
+    {
+        size = range.size();
+        return range.data();
+    }
+};
+
+#ifndef BOOST_NO_CXX11_HDR_ARRAY
+
+template<class V, std::size_t N>
+struct contiguous_range_traits< ::std::array<V, N> >
+{
+    template<class R>
+    static const R* data(const ::std::array<V, N>& range, std::size_t& size)
+    {
+        size = N;
+        return range.data();
+    }
+};
+
+#endif
+
+template<class V, std::size_t N>
+struct contiguous_range_traits<V[N]>
+{
+    template<class R>
+    static const R* data(const V (&range)[N], std::size_t& size)
+    {
+        size = N;
+        return range;
+    }
+};
+
 }
 
 /** INTERNAL ONLY */
@@ -240,8 +387,100 @@ struct random_access_iterator :
 
 #endif
 
+/**
+ * The @ref contiguous_iterator concept returns the address
+ * of the element that an iterator points to, when the
+ * iterator is known to be contiguous, as for pointers and
+ * the iterators of @c std::vector and @c std::basic_string.
+ * For other iterators it returns a null pointer, so that
+ * it can be added to a concept without restricting the
+ * types that model it.  With it, an algorithm can copy or
+ * reduce <code>[first, last)</code> as a block of memory
+ * when <code>first.contiguous_data()</code> is not null.
+ *
+ * Example:
+ *
+ * \code
+ * typedef any<
+ *     mpl::vector<
+ *         random_access_iterator<>,
+ *         same_type<random_access_iterator<>::value_type, int>,
+ *         contiguous_iterator<int>
+ *     >
+ * > int_iterator;
+ * const int* p = first != last? first.contiguous_data() : 0;
+ * if(p) {
+ *     std::memcpy(out, p, (last - first) * sizeof(int));
+ * } else {
+ *     std::copy(first, last, out);
+ * }
+ * \endcode
+ *
+ * \pre The iterator is dereferenceable, when it is contiguous.
+ * \pre When the iterator is contiguous, its @c value_type is
+ *      @c ValueType.
+ */
+template<class ValueType, class T = _self>
+struct contiguous_iterator
+{
+    static const ValueType* apply(const T& arg)
+    {
+        return ::boost::type_erasure::detail::contiguous_address<ValueType>(arg,
+            typename ::boost::type_erasure::detail::is_contiguous_iterator<T>::type());
+    }
+};
+
+/**
+ * The @ref contiguous_range concept returns the elements
+ * of a range as a pointer and a size, when the range is
+ * known to be contiguous, as for @c std::vector,
+ * @c std::basic_string, @c std::array and built-in
+ * arrays.  For other ranges the pointer is null and the
+ * size is 0.
+ *
+ * The @ref any gets the members @c contiguous_data() and
+ * @c contiguous_size().
+ *
+ * \pre When the range is contiguous, its elements are
+ *      @c ValueType.
+ */
+template<class ValueType, class T = _self>
+struct contiguous_range
+{
+    static const ValueType* apply(const T& arg, std::size_t& size)
+    {
+        return ::boost::type_erasure::detail::contiguous_range_traits<T>
+            ::template data<ValueType>(arg, size);
+    }
+};
+
 /// \cond show_operators
 
+template<class ValueType, class T, class Base>
+struct concept_interface<contiguous_iterator<ValueType, T>, Base, T> : Base
+{
+    const ValueType* contiguous_data() const
+    {
+        return ::boost::type_erasure::call(contiguous_iterator<ValueType, T>(), *this);
+    }
+};
+
+template<class ValueType, class T, class Base>
+struct concept_interface<contiguous_range<ValueType, T>, Base, T> : Base
+{
+    const ValueType* contiguous_data() const
+    {
+        std::size_t size;
+        return ::boost::type_erasure::call(contiguous_range<ValueType, T>(), *this, size);
+    }
+    std::size_t contiguous_size() const
+    {
+        std::size_t result;
+        ::boost::type_erasure::call(contiguous_range<ValueType, T>(), *this, result);
+        return result;
+    }
+};
+
 template<class T, class Reference, class DifferenceType, class ValueType, class Base>
 struct concept_interface<iterator< ::boost::no_traversal_tag, T, Reference, DifferenceType, ValueType>, Base, T>
     : Base
@@ -208,10 +208,10 @@ protected:
           : table(::boost::type_erasure::detail::access::table(u)),
             data(::boost::type_erasure::detail::access::data(u))
         {}
-        // It's safe to capture the table by reference, because
-        // the user's argument should out-live us.  storage is
-        // just a void*, so we don't need to add indirection.
-        const ::boost::type_erasure::binding<Concept>& table;
+        // binding and storage are each a single pointer, so
+        // they are copied rather than referenced.  This keeps
+        // param trivially copyable and avoids an indirection.
+        ::boost::type_erasure::binding<Concept> table;
         ::boost::type_erasure::detail::storage data;
     } _impl;
 };
@@ -36,30 +36,58 @@
 #include <boost/mpl/pair.hpp>
 #include <boost/mpl/back_inserter.hpp>
 #include <boost/mpl/for_each.hpp>
-#include <vector>
+#include <cstddef>
 #include <typeinfo>
 
 namespace boost {
 namespace type_erasure {
 namespace detail {
 
-typedef std::vector<const std::type_info*> key_type;
+// A key is an array holding the typeid of a normalized
+// primitive concept followed by the types bound to its
+// placeholders.  Keys are small and have a fixed size
+// for any given primitive concept, so they are built on
+// the stack, and lookup never allocates.
+typedef const std::type_info* key_element;
 typedef void (*value_type)();
-BOOST_TYPE_ERASURE_DECL void register_function_impl(const key_type& key, value_type fn);
-BOOST_TYPE_ERASURE_DECL value_type lookup_function_impl(const key_type& key);
+BOOST_TYPE_ERASURE_DECL void register_function_impl(const key_element* key, std::size_t size, value_type fn);
+// Returns null if there is no such function.
+BOOST_TYPE_ERASURE_DECL value_type find_function_impl(const key_element* key, std::size_t size);
+
+// Vtables that are built by converting a dynamic_binding
+// are cached, so that repeated conversions are cheap.
+// Once inserted, a table is shared and never changes.
+// insert_table_impl returns the table that is in the cache
+// afterwards, which may have been inserted by another thread.
+// The cache does not own the tables.
+BOOST_TYPE_ERASURE_DECL const void* lookup_table_impl(const key_element* key, std::size_t size);
+BOOST_TYPE_ERASURE_DECL const void* insert_table_impl(
+    const key_element* key, std::size_t size, const void* table);
+
+// The number of elements in the key of a primitive
+// concept with the given placeholders.
+template<class Placeholders>
+struct key_size
+{
+#ifndef BOOST_TYPE_ERASURE_USE_MP11
+    static const std::size_t value = ::boost::mpl::size<Placeholders>::value + 1;
+#else
+    static const std::size_t value = ::boost::mp11::mp_size<Placeholders>::value + 1;
+#endif
+};
 
 template<class Map>
 struct append_to_key_static {
-    append_to_key_static(key_type* k) : key(k) {} 
+    append_to_key_static(key_element*& k) : key(&k) {}
     template<class P>
     void operator()(P) {
 #ifndef BOOST_TYPE_ERASURE_USE_MP11
-        key->push_back(&typeid(typename ::boost::mpl::at<Map, P>::type));
+        *(*key)++ = &typeid(typename ::boost::mpl::at<Map, P>::type);
 #else
-        key->push_back(&typeid(::boost::mp11::mp_second< ::boost::mp11::mp_map_find<Map, P> >));
+        *(*key)++ = &typeid(::boost::mp11::mp_second< ::boost::mp11::mp_map_find<Map, P> >);
 #endif
     }
-    key_type* key;
+    key_element** key;
 };
 
 // This placeholder exists solely to create a normalized
@@ -93,55 +121,72 @@ struct counting_map_appender
     };
 };
 
+// The key of F, with its placeholders bound according to Map.
+template<class F, class Map>
+struct static_key
+{
+#ifndef BOOST_TYPE_ERASURE_USE_MP11
+    typedef typename ::boost::type_erasure::detail::get_placeholders<F, ::boost::mpl::set0<> >::type placeholders;
+#else
+    typedef typename ::boost::type_erasure::detail::get_placeholders<F, ::boost::mp11::mp_list<> >::type placeholders;
+#endif
+    typedef typename ::boost::mpl::fold<
+        placeholders,
+        ::boost::mpl::map0<>,
+        ::boost::type_erasure::detail::counting_map_appender
+    >::type placeholder_map;
+    static const std::size_t size = ::boost::type_erasure::detail::key_size<placeholders>::value;
+    static_key()
+    {
+        key_element* pos = key;
+        *pos++ = &typeid(typename ::boost::type_erasure::detail::rebind_placeholders<F, placeholder_map>::type);
+        ::boost::mpl::for_each<placeholders>(append_to_key_static<Map>(pos));
+    }
+    key_element key[size];
+};
+
 template<class Map>
 struct register_function {
     template<class F>
     void operator()(F) {
-        key_type key;
-#ifndef BOOST_TYPE_ERASURE_USE_MP11
-        typedef typename ::boost::type_erasure::detail::get_placeholders<F, ::boost::mpl::set0<> >::type placeholders;
-#else
-        typedef typename ::boost::type_erasure::detail::get_placeholders<F, ::boost::mp11::mp_list<> >::type placeholders;
-#endif
-        typedef typename ::boost::mpl::fold<
-            placeholders,
-            ::boost::mpl::map0<>,
-            ::boost::type_erasure::detail::counting_map_appender
-        >::type placeholder_map;
-        key.push_back(&typeid(typename ::boost::type_erasure::detail::rebind_placeholders<F, placeholder_map>::type));
-        ::boost::mpl::for_each<placeholders>(append_to_key_static<Map>(&key));
+        ::boost::type_erasure::detail::static_key<F, Map> k;
         value_type fn = reinterpret_cast<value_type>(&::boost::type_erasure::detail::rebind_placeholders<F, Map>::type::value);
-        ::boost::type_erasure::detail::register_function_impl(key, fn);
+        ::boost::type_erasure::detail::register_function_impl(k.key, k.size, fn);
     }
 };
 
-}
+template<class Map>
+struct check_function {
+    template<class F>
+    void operator()(F) {
+        ::boost::type_erasure::detail::static_key<F, Map> k;
+        if(::boost::type_erasure::detail::find_function_impl(k.key, k.size) == 0) {
+            *result = false;
+        }
+    }
+    bool* result;
+};
 
-/**
- * Registers a model of a concept to allow downcasting @ref any
- * via \dynamic_any_cast.
- */
+// The primitive concepts of Concept, as they are stored in the
+// registry, and the map that binds their placeholders.
 template<class Concept, class Map>
-void register_binding(const static_binding<Map>&)
+struct registered_concept
 {
     typedef typename ::boost::type_erasure::detail::normalize_concept<
         Concept
     >::type normalized;
     typedef typename ::boost::mpl::transform<normalized,
         ::boost::type_erasure::detail::maybe_adapt_to_vtable< ::boost::mpl::_1>
-    >::type actual_concept;
+    >::type type;
     typedef typename ::boost::type_erasure::detail::get_placeholder_normalization_map<
         Concept
     >::type placeholder_subs;
-    typedef typename ::boost::type_erasure::detail::add_deductions<Map, placeholder_subs>::type actual_map;
-    ::boost::mpl::for_each<actual_concept>(::boost::type_erasure::detail::register_function<actual_map>());
-}
+    typedef typename ::boost::type_erasure::detail::add_deductions<Map, placeholder_subs>::type map;
+};
 
-/**
- * \overload
- */
+// Binds the single non-deduced placeholder of Concept to T.
 template<class Concept, class T>
-void register_binding()
+struct single_placeholder_binding
 {
     // Find all placeholders
     typedef typename ::boost::type_erasure::detail::normalize_concept_impl<Concept>::type normalized;
@@ -171,8 +216,62 @@ void register_binding()
     >::type unknown_placeholders;
     // Bind the single remaining placeholder to T
     BOOST_MPL_ASSERT((boost::mpl::equal_to<boost::mpl::size<unknown_placeholders>, boost::mpl::int_<1> >));
-    register_binding<Concept>(::boost::type_erasure::make_binding<
-        ::boost::mpl::map< ::boost::mpl::pair<typename ::boost::mpl::front<unknown_placeholders>::type, T> > >());
+    typedef ::boost::type_erasure::static_binding<
+        ::boost::mpl::map< ::boost::mpl::pair<typename ::boost::mpl::front<unknown_placeholders>::type, T> >
+    > type;
+};
+
+}
+
+/**
+ * Registers a model of a concept to allow downcasting @ref any
+ * via \dynamic_any_cast.
+ */
+template<class Concept, class Map>
+void register_binding(const static_binding<Map>&)
+{
+    typedef ::boost::type_erasure::detail::registered_concept<Concept, Map> registered;
+    ::boost::mpl::for_each<typename registered::type>(
+        ::boost::type_erasure::detail::register_function<typename registered::map>());
+}
+
+/**
+ * \overload
+ */
+template<class Concept, class T>
+void register_binding()
+{
+    register_binding<Concept>(
+        typename ::boost::type_erasure::detail::single_placeholder_binding<Concept, T>::type());
+}
+
+/**
+ * \return true iff a model of @c Concept with the
+ *         given binding has been registered via
+ *         \register_binding.  This is the same
+ *         condition under which \dynamic_any_cast
+ *         to an @ref any with @c Concept can succeed.
+ *
+ * \throws Nothing.
+ */
+template<class Concept, class Map>
+bool is_registered(const static_binding<Map>&)
+{
+    typedef ::boost::type_erasure::detail::registered_concept<Concept, Map> registered;
+    bool result = true;
+    ::boost::type_erasure::detail::check_function<typename registered::map> f = { &result };
+    ::boost::mpl::for_each<typename registered::type>(f);
+    return result;
+}
+
+/**
+ * \overload
+ */
+template<class Concept, class T>
+bool is_registered()
+{
+    return is_registered<Concept>(
+        typename ::boost::type_erasure::detail::single_placeholder_binding<Concept, T>::type());
 }
 
 }
@@ -0,0 +1,52 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#ifndef BOOST_TYPE_ERASURE_SMALL_BUFFER_HPP_INCLUDED
+#define BOOST_TYPE_ERASURE_SMALL_BUFFER_HPP_INCLUDED
+
+#include <cstddef>
+#include <boost/mpl/vector.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+
+namespace boost {
+namespace type_erasure {
+
+/**
+ * This special concept makes @ref any store objects of up
+ * to @c Size bytes with an alignment of at most @c Align
+ * inside the @ref any itself instead of allocating them on
+ * the heap.  Larger or over-aligned types, and types whose
+ * move constructor may throw, still use the heap.
+ * The result of a call that returns a placeholder by value,
+ * such as <code>x + y</code>, is constructed directly in the
+ * buffer of the @ref any that receives it.
+ *
+ * @ref small_buffer only changes how a value @ref any stores
+ * its object, so it has no effect on references.  Pointers
+ * and references to an object held in the buffer are
+ * invalidated when the @ref any is swapped or assigned
+ * by construction, just like they would be by the
+ * destruction of the @ref any.
+ *
+ * \note @ref small_buffer is only supported when the compiler
+ * provides rvalue references, variadic templates and
+ * inheriting constructors.  Otherwise it is ignored.
+ */
+template<
+    std::size_t Size = 3 * sizeof(void*),
+    std::size_t Align = ::boost::alignment_of< ::boost::detail::max_align>::value
+>
+struct small_buffer : ::boost::mpl::vector0<> {};
+
+}
+}
+
+#endif
@@ -16,6 +16,7 @@
 #include <boost/type_erasure/detail/access.hpp>
 #include <boost/type_erasure/any.hpp>
 #include <boost/type_erasure/binding.hpp>
+#include <boost/type_erasure/detail/type_token.hpp>
 
 namespace boost {
 namespace type_erasure {
@@ -32,26 +33,22 @@ namespace type_erasure {
 template<class Concept, class T>
 const std::type_info& typeid_of(const any<Concept, T>& arg)
 {
-    return ::boost::type_erasure::detail::access::table(arg).template find<
-        ::boost::type_erasure::typeid_<
-            typename ::boost::remove_cv<
-                typename ::boost::remove_reference<T>::type
-            >::type
-        >
-    >()();
+    return ::boost::type_erasure::detail::bound_type<
+        typename ::boost::remove_cv<
+            typename ::boost::remove_reference<T>::type
+        >::type
+    >(::boost::type_erasure::detail::access::table(arg));
 }
 
 #ifndef BOOST_TYPE_ERASURE_DOXYGEN
 template<class Concept, class T>
 const std::type_info& typeid_of(const param<Concept, T>& arg)
 {
-    return ::boost::type_erasure::detail::access::table(arg).template find<
-        ::boost::type_erasure::typeid_<
-            typename ::boost::remove_cv<
-                typename ::boost::remove_reference<T>::type
-            >::type
-        >
-    >()();
+    return ::boost::type_erasure::detail::bound_type<
+        typename ::boost::remove_cv<
+            typename ::boost::remove_reference<T>::type
+        >::type
+    >(::boost::type_erasure::detail::access::table(arg));
 }
 #endif
 
@@ -61,7 +58,7 @@ const std::type_info& typeid_of(const param<Concept, T>& arg)
 template<class T, class Concept>
 const std::type_info& typeid_of(const binding<Concept>& binding_arg)
 {
-    return binding_arg.template find< ::boost::type_erasure::typeid_<T> >()();
+    return ::boost::type_erasure::detail::bound_type<T>(binding_arg);
 }
 
 }
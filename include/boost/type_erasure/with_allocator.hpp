@@ -0,0 +1,57 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#ifndef BOOST_TYPE_ERASURE_WITH_ALLOCATOR_HPP_INCLUDED
+#define BOOST_TYPE_ERASURE_WITH_ALLOCATOR_HPP_INCLUDED
+
+#include <boost/mpl/vector.hpp>
+
+namespace boost {
+namespace type_erasure {
+
+/**
+ * This special concept makes @ref any allocate the objects
+ * that it holds with @c Alloc instead of @c new.  Any
+ * standard conforming allocator can be used; it is rebound
+ * as needed.  Types with an alignment greater than that
+ * of @c std::max_align_t are still allocated with @c new.
+ * When combined with @ref small_buffer, only objects that
+ * do not fit in the buffer use the allocator.
+ *
+ * @c Alloc must be DefaultConstructible.  An @ref any
+ * constructed from a value uses a default constructed
+ * allocator, unless one is passed explicitly:
+ *
+ * \code
+ * any<mpl::vector<copy_constructible<>, with_allocator<A> > >
+ *     x(std::allocator_arg, a, value);
+ * \endcode
+ *
+ * The allocator travels with the object.  Copying or moving
+ * an @ref any copies its allocator and swapping two @ref any
+ * "anys" swaps their allocators as well.  Thus, assignment
+ * that falls back on construction also replaces the allocator.
+ * An @ref any that is converted from another @ref any type
+ * uses a default constructed allocator.
+ *
+ * @ref with_allocator only changes how a value @ref any stores
+ * its object, so it has no effect on references.
+ *
+ * \note @ref with_allocator is only supported when the compiler
+ * provides rvalue references, variadic templates and
+ * inheriting constructors.  Otherwise it is ignored.
+ */
+template<class Alloc>
+struct with_allocator : ::boost::mpl::vector0<> {};
+
+}
+}
+
+#endif
@@ -11,47 +11,194 @@
 #define BOOST_TYPE_ERASURE_SOURCE
 
 #include <boost/type_erasure/register_binding.hpp>
-#include <boost/thread/shared_mutex.hpp>
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
 #include <boost/thread/lock_types.hpp>
-#include <map>
-#include <utility>
+#include <boost/functional/hash.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
 
 namespace {
-    
-using ::boost::type_erasure::detail::key_type;
+
+using ::boost::type_erasure::detail::key_element;
 using ::boost::type_erasure::detail::value_type;
 
-typedef ::std::map<key_type, void(*)()> map_type;
-typedef ::boost::shared_mutex mutex_type;
+// Entries are never removed, so they live until the
+// end of the program and can be shared by every table.
+template<class Value>
+struct entry_type
+{
+    entry_type(const key_element* k, std::size_t size, const Value& v, std::size_t h)
+      : key(k, k + size), value(v), hash(h) {}
+    bool matches(const key_element* k, std::size_t size, std::size_t h) const
+    {
+        return hash == h && key.size() == size && std::equal(key.begin(), key.end(), k);
+    }
+    std::vector<key_element> key;
+    Value value;
+    std::size_t hash;
+};
+
+// An open addressing hash table with linear probing.
+// Readers never lock.  A writer fills an empty slot only
+// after the entry is complete, and publishes a larger
+// table once the old one is half full.  Old tables are
+// kept, since a reader may still be using them, but as
+// the capacity doubles each time, they take no more
+// memory than the current table.
+template<class Value>
+struct table_type
+{
+    typedef ::boost::atomic<const entry_type<Value>*> slot_type;
+    explicit table_type(std::size_t n)
+      : slots(new slot_type[n]), capacity(n), size(0), next(0)
+    {
+        for(std::size_t i = 0; i < n; ++i) {
+            slots[i].store(0, ::boost::memory_order_relaxed);
+        }
+    }
+    ~table_type() { delete[] slots; }
+    const entry_type<Value>* find(const key_element* key, std::size_t key_size, std::size_t h) const
+    {
+        std::size_t mask = capacity - 1;
+        for(std::size_t i = h & mask;; i = (i + 1) & mask) {
+            const entry_type<Value>* e = slots[i].load(::boost::memory_order_acquire);
+            if(e == 0) return 0;
+            if(e->matches(key, key_size, h)) return e;
+        }
+    }
+    void insert(const entry_type<Value>* e)
+    {
+        std::size_t mask = capacity - 1;
+        std::size_t i = e->hash & mask;
+        while(slots[i].load(::boost::memory_order_relaxed) != 0) {
+            i = (i + 1) & mask;
+        }
+        slots[i].store(e, ::boost::memory_order_release);
+        ++size;
+    }
+    slot_type* slots;
+    std::size_t capacity;
+    std::size_t size;
+    table_type* next;
+private:
+    table_type(const table_type&);
+    table_type& operator=(const table_type&);
+};
+
+std::size_t hash_key(const key_element* key, std::size_t size)
+{
+    std::size_t result = 0;
+    for(std::size_t i = 0; i < size; ++i) {
+        ::boost::hash_combine(result, key[i]);
+    }
+    return result;
+}
+
+typedef ::boost::mutex mutex_type;
 
-// std::pair can have problems on older implementations
-// when it tries to use the copy constructor of the mutex.
-struct data_type
+template<class Value>
+class registry
 {
-    map_type first;
-    mutex_type second;
+public:
+    registry() : table(0), retired(0) {}
+    ~registry()
+    {
+        table_type<Value>* t = table.load(::boost::memory_order_relaxed);
+        if(t != 0) {
+            for(std::size_t i = 0; i < t->capacity; ++i) {
+                delete t->slots[i].load(::boost::memory_order_relaxed);
+            }
+            t->next = retired;
+            retired = t;
+        }
+        while(retired != 0) {
+            table_type<Value>* n = retired->next;
+            delete retired;
+            retired = n;
+        }
+    }
+    const Value* find(const key_element* key, std::size_t size) const
+    {
+        const table_type<Value>* t = table.load(::boost::memory_order_acquire);
+        if(t != 0) {
+            if(const entry_type<Value>* e = t->find(key, size, ::hash_key(key, size))) {
+                return &e->value;
+            }
+        }
+        return 0;
+    }
+    // Returns the value that is in the registry afterwards.
+    // The first insertion of a key wins, as with std::map::insert.
+    const Value& insert(const key_element* key, std::size_t size, const Value& value)
+    {
+        ::boost::unique_lock<mutex_type> lock(mutex);
+        std::size_t h = ::hash_key(key, size);
+        table_type<Value>* t = table.load(::boost::memory_order_relaxed);
+        if(t != 0) {
+            if(const entry_type<Value>* e = t->find(key, size, h)) {
+                return e->value;
+            }
+        }
+        if(t == 0 || 2 * (t->size + 1) > t->capacity) {
+            table_type<Value>* new_table = new table_type<Value>(t == 0? 64 : 2 * t->capacity);
+            if(t != 0) {
+                for(std::size_t i = 0; i < t->capacity; ++i) {
+                    const entry_type<Value>* e = t->slots[i].load(::boost::memory_order_relaxed);
+                    if(e != 0) new_table->insert(e);
+                }
+                t->next = retired;
+                retired = t;
+            }
+            table.store(new_table, ::boost::memory_order_release);
+            t = new_table;
+        }
+        const entry_type<Value>* e = new entry_type<Value>(key, size, value, h);
+        t->insert(e);
+        return e->value;
+    }
+private:
+    ::boost::atomic<table_type<Value>*> table;
+    // guards writers only
+    mutex_type mutex;
+    table_type<Value>* retired;
 };
 
-data_type * get_data() {
-    static data_type result;
+registry<value_type> * get_functions() {
+    static registry<value_type> result;
+    return &result;
+}
+
+registry<const void*> * get_tables() {
+    static registry<const void*> result;
     return &result;
 }
 
 }
 
-BOOST_TYPE_ERASURE_DECL void boost::type_erasure::detail::register_function_impl(const key_type& key, value_type fn) {
-    ::data_type * data = ::get_data();
-    ::boost::unique_lock<mutex_type> lock(data->second);
-    data->first.insert(std::make_pair(key, fn));
+BOOST_TYPE_ERASURE_DECL void boost::type_erasure::detail::register_function_impl(
+    const key_element* key, std::size_t size, value_type fn)
+{
+    ::get_functions()->insert(key, size, fn);
 }
 
-BOOST_TYPE_ERASURE_DECL value_type boost::type_erasure::detail::lookup_function_impl(const key_type& key) {
-    ::data_type * data = ::get_data();
-    ::boost::shared_lock<mutex_type> lock(data->second);
-    ::map_type::const_iterator pos = data->first.find(key);
-    if(pos != data->first.end()) {
-        return pos->second;
-    } else {
-        throw bad_any_cast();
-    }
+BOOST_TYPE_ERASURE_DECL value_type boost::type_erasure::detail::find_function_impl(
+    const key_element* key, std::size_t size)
+{
+    const value_type* result = ::get_functions()->find(key, size);
+    return result? *result : 0;
+}
+
+BOOST_TYPE_ERASURE_DECL const void* boost::type_erasure::detail::lookup_table_impl(
+    const key_element* key, std::size_t size)
+{
+    const void* const* result = ::get_tables()->find(key, size);
+    return result? *result : 0;
+}
+
+BOOST_TYPE_ERASURE_DECL const void* boost::type_erasure::detail::insert_table_impl(
+    const key_element* key, std::size_t size, const void* table)
+{
+    return ::get_tables()->insert(key, size, table);
 }
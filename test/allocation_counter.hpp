@@ -0,0 +1,45 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#ifndef BOOST_TYPE_ERASURE_TEST_ALLOCATION_COUNTER_HPP_INCLUDED
+#define BOOST_TYPE_ERASURE_TEST_ALLOCATION_COUNTER_HPP_INCLUDED
+
+// Replaces the global operator new to count the allocations
+// that a test makes.  Include it in only one file of each test.
+//
+// The replacements are never inlined.  Otherwise, GCC sees
+// std::free called on a pointer from operator new and warns
+// about mismatched allocation functions.
+
+#include <boost/config.hpp>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+std::size_t allocations = 0;
+
+BOOST_NOINLINE void* operator new(std::size_t size)
+{
+    ++allocations;
+    if(void* result = std::malloc(size ? size : 1)) return result;
+    throw std::bad_alloc();
+}
+
+BOOST_NOINLINE void operator delete(void* ptr) BOOST_NOEXCEPT_OR_NOTHROW
+{
+    std::free(ptr);
+}
+
+BOOST_NOINLINE void operator delete(void* ptr, std::size_t) BOOST_NOEXCEPT_OR_NOTHROW
+{
+    std::free(ptr);
+}
+
+#endif
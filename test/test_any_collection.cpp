@@ -0,0 +1,159 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#include <boost/type_erasure/any_collection.hpp>
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/builtin.hpp>
+#include <boost/type_erasure/operators.hpp>
+#include <boost/type_erasure/any_cast.hpp>
+#include <boost/type_erasure/typeid_of.hpp>
+#include <boost/mpl/vector.hpp>
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::type_erasure;
+
+typedef ::boost::mpl::vector<
+    copy_constructible<>,
+    typeid_<>,
+    incrementable<>
+> test_concept;
+
+struct counted
+{
+    counted() : value(0) { ++count; }
+    counted(const counted& other) : value(other.value) { ++count; }
+    explicit counted(int v) : value(v) { ++count; }
+    ~counted() { --count; }
+    counted& operator++() { ++value; return *this; }
+    int value;
+    static int count;
+};
+
+int counted::count = 0;
+
+struct increment
+{
+    template<class R>
+    void operator()(R arg) const { ++arg; }
+};
+
+struct record
+{
+    explicit record(std::vector<const std::type_info*>& o) : out(&o) {}
+    template<class R>
+    void operator()(R arg) const { out->push_back(&typeid_of(arg)); }
+    std::vector<const std::type_info*>* out;
+};
+
+BOOST_AUTO_TEST_CASE(test_insert)
+{
+    any_collection<test_concept> c;
+    BOOST_CHECK(c.empty());
+    c.insert(1);
+    c.insert(1.5);
+    c.insert(2);
+    any<test_concept, _self&> x = c.insert(3);
+    BOOST_CHECK_EQUAL(c.size(), 4u);
+    BOOST_CHECK_EQUAL(any_cast<int>(x), 3);
+}
+
+// The elements of each type are together, in the order
+// that they were inserted.
+BOOST_AUTO_TEST_CASE(test_iterate)
+{
+    any_collection<test_concept> c;
+    c.insert(1);
+    c.insert(1.5);
+    c.insert(2);
+    c.insert(2.5);
+    c.insert(3);
+    std::vector<double> values;
+    for(any_collection<test_concept>::iterator iter = c.begin(), end = c.end(); iter != end; ++iter) {
+        if(typeid_of(*iter) == typeid(int)) {
+            values.push_back(any_cast<int>(*iter));
+        } else {
+            values.push_back(any_cast<double>(*iter));
+        }
+    }
+    double expected[] = { 1, 2, 3, 1.5, 2.5 };
+    BOOST_CHECK_EQUAL_COLLECTIONS(values.begin(), values.end(), &expected[0], &expected[0] + 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_for_each)
+{
+    any_collection<test_concept> c;
+    c.insert(1);
+    c.insert(1.5);
+    c.insert(2);
+    c.for_each(increment());
+    any_collection<test_concept>::iterator iter = c.begin();
+    BOOST_CHECK_EQUAL(any_cast<int>(*iter), 2);
+    ++iter;
+    BOOST_CHECK_EQUAL(any_cast<int>(*iter), 3);
+    ++iter;
+    BOOST_CHECK_EQUAL(any_cast<double>(*iter), 2.5);
+    ++iter;
+    BOOST_CHECK(iter == c.end());
+
+    const any_collection<test_concept>& cc = c;
+    std::vector<const std::type_info*> types;
+    cc.for_each(record(types));
+    BOOST_REQUIRE_EQUAL(types.size(), 3u);
+    BOOST_CHECK(*types[0] == typeid(int));
+    BOOST_CHECK(*types[1] == typeid(int));
+    BOOST_CHECK(*types[2] == typeid(double));
+    BOOST_CHECK_EQUAL(any_cast<double>(*++++cc.begin()), 2.5);
+}
+
+BOOST_AUTO_TEST_CASE(test_empty)
+{
+    any_collection<test_concept> c;
+    BOOST_CHECK(c.begin() == c.end());
+    c.insert(1);
+    c.clear();
+    BOOST_CHECK(c.empty());
+    BOOST_CHECK(c.begin() == c.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_destroy)
+{
+    {
+        any_collection<test_concept> c;
+        c.insert(counted(1));
+        c.insert(counted(2));
+        c.insert(1);
+        c.for_each(increment());
+        BOOST_CHECK_EQUAL(any_cast<const counted&>(*c.begin()).value, 2);
+        BOOST_CHECK_EQUAL(counted::count, 2);
+    }
+    BOOST_CHECK_EQUAL(counted::count, 0);
+}
+
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+
+BOOST_AUTO_TEST_CASE(test_emplace)
+{
+    any_collection<test_concept> c;
+    c.emplace<counted>(5);
+    c.emplace<int>(1);
+    any_collection<test_concept> d(std::move(c));
+    BOOST_CHECK(c.empty());
+    BOOST_CHECK_EQUAL(d.size(), 2u);
+    BOOST_CHECK_EQUAL(any_cast<const counted&>(*d.begin()).value, 5);
+    d = std::move(c);
+    BOOST_CHECK(d.empty());
+    BOOST_CHECK_EQUAL(counted::count, 0);
+}
+
+#endif
@@ -0,0 +1,154 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#include <boost/type_erasure/any_vector.hpp>
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/builtin.hpp>
+#include <boost/type_erasure/operators.hpp>
+#include <boost/type_erasure/any_cast.hpp>
+#include <boost/type_erasure/typeid_of.hpp>
+#include <boost/mpl/vector.hpp>
+#include <vector>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::type_erasure;
+
+typedef ::boost::mpl::vector<
+    copy_constructible<>,
+    typeid_<>,
+    incrementable<>
+> test_concept;
+
+struct counted
+{
+    counted() : value(0) { ++count; }
+    counted(const counted& other) : value(other.value) { ++count; }
+    explicit counted(int v) : value(v) { ++count; }
+    ~counted() { --count; }
+    counted& operator++() { ++value; return *this; }
+    int value;
+    static int count;
+};
+
+int counted::count = 0;
+
+struct increment
+{
+    template<class R>
+    void operator()(R arg) const { ++arg; }
+};
+
+struct count_ints
+{
+    count_ints() : n(0) {}
+    template<class R>
+    void operator()(R arg) { if(typeid_of(arg) == typeid(int)) ++n; }
+    int n;
+};
+
+BOOST_AUTO_TEST_CASE(test_push_back)
+{
+    any_vector<test_concept> v;
+    BOOST_CHECK(v.empty());
+    v.push_back(1);
+    v.push_back(1.5);
+    v.push_back(2);
+    BOOST_CHECK_EQUAL(v.size(), 3u);
+    BOOST_CHECK_EQUAL(any_cast<int>(v[0]), 1);
+    BOOST_CHECK_EQUAL(any_cast<double>(v[1]), 1.5);
+    BOOST_CHECK_EQUAL(any_cast<int>(v[2]), 2);
+    ++v[0];
+    BOOST_CHECK_EQUAL(any_cast<int>(v[0]), 2);
+    const any_vector<test_concept>& cv = v;
+    BOOST_CHECK_EQUAL(any_cast<int>(cv[2]), 2);
+}
+
+// Adding elements keeps the existing objects in place.
+BOOST_AUTO_TEST_CASE(test_stable)
+{
+    any_vector<test_concept> v;
+    v.push_back(counted(1));
+    const counted* p = &any_cast<const counted&>(v[0]);
+    for(int i = 0; i < 100; ++i) {
+        v.push_back(i);
+    }
+    BOOST_CHECK_EQUAL(&any_cast<const counted&>(v[0]), p);
+}
+
+BOOST_AUTO_TEST_CASE(test_iterate)
+{
+    any_vector<test_concept> v;
+    for(int i = 0; i < 20; ++i) {
+        if(i % 3 == 0) {
+            v.push_back(static_cast<double>(i));
+        } else {
+            v.push_back(i);
+        }
+    }
+    v.for_each(increment());
+    int i = 0;
+    for(any_vector<test_concept>::const_iterator iter = v.begin(), end = v.end(); iter != end; ++iter, ++i) {
+        if(i % 3 == 0) {
+            BOOST_CHECK_EQUAL(any_cast<double>(*iter), i + 1);
+        } else {
+            BOOST_CHECK_EQUAL(any_cast<int>(*iter), i + 1);
+        }
+    }
+    BOOST_CHECK_EQUAL(i, 20);
+    BOOST_CHECK_EQUAL(v.end() - v.begin(), 20);
+    BOOST_CHECK_EQUAL(any_cast<int>(*(v.begin() + 4)), 5);
+    const any_vector<test_concept>& cv = v;
+    BOOST_CHECK_EQUAL(cv.for_each(count_ints()).n, 13);
+}
+
+BOOST_AUTO_TEST_CASE(test_empty)
+{
+    any_vector<test_concept> v;
+    BOOST_CHECK(v.begin() == v.end());
+    BOOST_CHECK_EQUAL(v.for_each(count_ints()).n, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_destroy)
+{
+    {
+        any_vector<test_concept> v;
+        v.push_back(counted(1));
+        v.push_back(1);
+        v.push_back(counted(2));
+        BOOST_CHECK_EQUAL(counted::count, 2);
+        v.pop_back();
+        BOOST_CHECK_EQUAL(counted::count, 1);
+        v.push_back(counted(3));
+        v.clear();
+        BOOST_CHECK_EQUAL(counted::count, 0);
+        v.push_back(counted(4));
+    }
+    BOOST_CHECK_EQUAL(counted::count, 0);
+}
+
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+
+BOOST_AUTO_TEST_CASE(test_emplace)
+{
+    any_vector<test_concept> v;
+    v.emplace_back<counted>(5);
+    v.emplace_back<int>(3);
+    any_vector<test_concept> w(std::move(v));
+    BOOST_CHECK(v.empty());
+    BOOST_CHECK_EQUAL(any_cast<const counted&>(w[0]).value, 5);
+    BOOST_CHECK_EQUAL(any_cast<int>(w[1]), 3);
+    w = std::move(v);
+    BOOST_CHECK(w.empty());
+    BOOST_CHECK_EQUAL(counted::count, 0);
+}
+
+#endif
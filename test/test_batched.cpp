@@ -0,0 +1,175 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#include <boost/type_erasure/batched.hpp>
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/builtin.hpp>
+#include <boost/type_erasure/callable.hpp>
+#include <boost/type_erasure/member.hpp>
+#include <boost/type_erasure/call.hpp>
+#include <boost/type_erasure/any_cast.hpp>
+#include <boost/mpl/vector.hpp>
+#include <cstddef>
+#include <vector>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::type_erasure;
+
+BOOST_TYPE_ERASURE_MEMBER((has_push), push, 1)
+BOOST_TYPE_ERASURE_MEMBER((has_observe), observe, 1)
+BOOST_TYPE_ERASURE_MEMBER((has_total), total, 1)
+
+struct summer
+{
+    summer() : sum(0), calls(0) {}
+    void operator()(const int& i) { sum += i; ++calls; }
+    void operator()(const double& d) { sum += static_cast<int>(d * 10); ++calls; }
+    int sum;
+    int calls;
+};
+
+struct recorder
+{
+    recorder() : observed(0) {}
+    void push(int i) { values.push_back(i); }
+    void observe(int i) const { observed += i; }
+    int total(int scale) const
+    {
+        int result = 0;
+        for(std::size_t i = 0; i < values.size(); ++i) {
+            result += values[i] * scale;
+        }
+        return result;
+    }
+    std::vector<int> values;
+    mutable int observed;
+};
+
+struct doubler
+{
+    void operator()(int& i) const { i *= 2; }
+};
+
+BOOST_AUTO_TEST_CASE(test_callable)
+{
+    typedef ::boost::mpl::vector<
+        copy_constructible<>,
+        typeid_<>,
+        callable<void(const int&)>,
+        batched<callable<void(const int&)> >
+    > test_concept;
+    any<test_concept> x((summer()));
+    int values[] = { 1, 2, 3, 4 };
+    x.call_batch(values, 4);
+    x(5);
+    BOOST_CHECK_EQUAL(any_cast<const summer&>(x).sum, 15);
+    BOOST_CHECK_EQUAL(any_cast<const summer&>(x).calls, 5);
+    x.call_batch(values, 0);
+    BOOST_CHECK_EQUAL(any_cast<const summer&>(x).calls, 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_member)
+{
+    typedef ::boost::mpl::vector<
+        copy_constructible<>,
+        typeid_<>,
+        batched<has_push<void(int)> >
+    > test_concept;
+    any<test_concept> x((recorder()));
+    int values[] = { 3, 1, 4, 1, 5 };
+    x.call_batch(values, 5);
+    const std::vector<int>& result = any_cast<const recorder&>(x).values;
+    BOOST_CHECK_EQUAL_COLLECTIONS(result.begin(), result.end(), &values[0], &values[0] + 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_const)
+{
+    typedef ::boost::mpl::vector<
+        copy_constructible<>,
+        typeid_<>,
+        batched<has_observe<void(int), const _self> >,
+        batched<has_total<int(long), const _self> >
+    > test_concept;
+    const any<test_concept> x((recorder()));
+    int values[] = { 1, 2, 3 };
+    x.call_batch(values, 3);
+    any<test_concept, const _self&> y(x);
+    y.call_batch(values, 3);
+    BOOST_CHECK_EQUAL(any_cast<const recorder&>(x).observed, 12);
+    // The results are discarded.
+    long scales[] = { 1, 2 };
+    x.call_batch(scales, 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_modify)
+{
+    typedef ::boost::mpl::vector<
+        copy_constructible<>,
+        batched<callable<void(int&), const _self> >
+    > test_concept;
+    any<test_concept> x((doubler()));
+    std::vector<int> values;
+    for(int i = 0; i < 10; ++i) {
+        values.push_back(i);
+    }
+    x.call_batch(&values[0], values.size());
+    for(int i = 0; i < 10; ++i) {
+        BOOST_CHECK_EQUAL(values[i], 2 * i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_overload)
+{
+    typedef ::boost::mpl::vector<
+        copy_constructible<>,
+        typeid_<>,
+        batched<callable<void(const int&)> >,
+        batched<callable<void(const double&)> >
+    > test_concept;
+    any<test_concept> x((summer()));
+    int ints[] = { 1, 2 };
+    double doubles[] = { 0.5, 1.5 };
+    x.call_batch(ints, 2);
+    x.call_batch(doubles, 2);
+    BOOST_CHECK_EQUAL(any_cast<const summer&>(x).sum, 23);
+    BOOST_CHECK_EQUAL(any_cast<const summer&>(x).calls, 4);
+}
+
+BOOST_AUTO_TEST_CASE(test_reference)
+{
+    typedef ::boost::mpl::vector<
+        copy_constructible<>,
+        typeid_<>,
+        batched<callable<void(const int&)> >
+    > test_concept;
+    summer s;
+    any<test_concept, _self&> x(s);
+    int values[] = { 1, 2, 3 };
+    x.call_batch(values, 3);
+    const int* first = values;
+    std::size_t n = 3;
+    call(batched<callable<void(const int&)> >(), x, first, n);
+    BOOST_CHECK_EQUAL(s.sum, 12);
+}
+
+BOOST_AUTO_TEST_CASE(test_placeholder)
+{
+    typedef ::boost::mpl::vector<
+        copy_constructible<_a>,
+        typeid_<_a>,
+        batched<callable<void(const int&), _a> >
+    > test_concept;
+    any<test_concept, _a> x((summer()));
+    int values[] = { 1, 2, 3 };
+    x.call_batch(values, 3);
+    BOOST_CHECK_EQUAL(any_cast<const summer&>(x).sum, 6);
+}
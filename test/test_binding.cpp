@@ -14,10 +14,13 @@
 #include <boost/type_erasure/builtin.hpp>
 #include <boost/mpl/vector.hpp>
 #include <boost/mpl/map.hpp>
+#include <cstddef>
 
 #define BOOST_TEST_MAIN
 #include <boost/test/unit_test.hpp>
 
+#include "allocation_counter.hpp"
+
 using namespace boost::type_erasure;
 
 BOOST_AUTO_TEST_CASE(test_empty_binding)
@@ -126,3 +129,41 @@ BOOST_AUTO_TEST_CASE(test_binding_two)
     BOOST_CHECK(b10.find<typeid_<_b> >()() == typeid(int));
     BOOST_CHECK(b10.find<typeid_<_a> >()() == typeid(char));
 }
+
+BOOST_AUTO_TEST_CASE(test_convert_reuses_table)
+{
+    typedef boost::mpl::vector<typeid_<_a>, typeid_<_b> > source_concept;
+    binding<source_concept> b1(make_binding<boost::mpl::map<boost::mpl::pair<_a, int>, boost::mpl::pair<_b, char> > >());
+    binding<source_concept> b2(make_binding<boost::mpl::map<boost::mpl::pair<_a, double>, boost::mpl::pair<_b, int> > >());
+    boost::mpl::map<boost::mpl::pair<_c, _b> > m;
+    binding<typeid_<_c> > c1(b1, m);
+    binding<typeid_<_c> > c2(b2, m);
+    BOOST_CHECK(c1.find<typeid_<_c> >()() == typeid(char));
+    BOOST_CHECK(c2.find<typeid_<_c> >()() == typeid(int));
+    std::size_t before = allocations;
+    for(int i = 0; i < 10; ++i) {
+        binding<typeid_<_c> > c3(b1, m);
+        BOOST_CHECK(c3 == c1);
+        binding<typeid_<_c> > c4(b2, m);
+        BOOST_CHECK(c4 == c2);
+        binding<typeid_<_c> > c5(c4);
+        BOOST_CHECK(c5.find<typeid_<_c> >()() == typeid(int));
+    }
+    BOOST_CHECK_EQUAL(allocations, before);
+}
+
+// Equal converted tables share one copy, but still compare
+// equal to the static table.
+BOOST_AUTO_TEST_CASE(test_convert_canonical)
+{
+    typedef boost::mpl::vector<typeid_<_a>, typeid_<_b> > source_concept;
+    binding<source_concept> b1(make_binding<boost::mpl::map<boost::mpl::pair<_a, int>, boost::mpl::pair<_b, char> > >());
+    binding<source_concept> b2(make_binding<boost::mpl::map<boost::mpl::pair<_a, double>, boost::mpl::pair<_b, char> > >());
+    boost::mpl::map<boost::mpl::pair<_c, _b> > m;
+    binding<typeid_<_c> > c1(b1, m);
+    binding<typeid_<_c> > c2(b2, m);
+    BOOST_CHECK(c1 == c2);
+    binding<typeid_<_c> > c3(b1, boost::mpl::map<boost::mpl::pair<_c, _a> >());
+    BOOST_CHECK(c1 != c3);
+    BOOST_CHECK(c3 == binding<typeid_<_c> >(make_binding<boost::mpl::map<boost::mpl::pair<_c, int> > >()));
+}
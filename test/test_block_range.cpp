@@ -0,0 +1,98 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#include <boost/type_erasure/block_range.hpp>
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/builtin.hpp>
+#include <boost/type_erasure/any_cast.hpp>
+#include <boost/mpl/vector.hpp>
+#include <list>
+#include <vector>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::type_erasure;
+
+typedef ::boost::mpl::vector<
+    copy_constructible<>,
+    block_readable<int>
+> test_concept;
+
+template<class Source>
+std::vector<std::size_t> read_all(Source& source, std::vector<int>& out)
+{
+    std::vector<std::size_t> sizes;
+    int buffer[3];
+    std::size_t n;
+    do {
+        n = source.next_block(buffer, 3);
+        sizes.push_back(n);
+        out.insert(out.end(), buffer, buffer + n);
+    } while(n != 0);
+    return sizes;
+}
+
+static std::vector<int> make_values()
+{
+    std::vector<int> result;
+    for(int i = 0; i < 10; ++i) {
+        result.push_back(i);
+    }
+    return result;
+}
+
+BOOST_AUTO_TEST_CASE(test_random_access)
+{
+    std::vector<int> v = make_values();
+    any<test_concept> source(make_block_range(v.begin(), v.end()));
+    std::vector<int> out;
+    std::vector<std::size_t> sizes = read_all(source, out);
+    BOOST_CHECK_EQUAL_COLLECTIONS(out.begin(), out.end(), v.begin(), v.end());
+    std::size_t expected[] = { 3, 3, 3, 1, 0 };
+    BOOST_CHECK_EQUAL_COLLECTIONS(sizes.begin(), sizes.end(), &expected[0], &expected[0] + 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_forward)
+{
+    std::vector<int> v = make_values();
+    std::list<int> l(v.begin(), v.end());
+    any<test_concept> source(make_block_range(l.begin(), l.end()));
+    std::vector<int> out;
+    std::vector<std::size_t> sizes = read_all(source, out);
+    BOOST_CHECK_EQUAL_COLLECTIONS(out.begin(), out.end(), v.begin(), v.end());
+    BOOST_CHECK_EQUAL(sizes.size(), 5u);
+}
+
+// A copy reads from the same position independently.
+BOOST_AUTO_TEST_CASE(test_copy)
+{
+    std::vector<int> v = make_values();
+    any<test_concept> source(make_block_range(v.begin(), v.end()));
+    int buffer[4];
+    BOOST_CHECK_EQUAL(source.next_block(buffer, 4), 4u);
+    any<test_concept> copy(source);
+    BOOST_CHECK_EQUAL(source.next_block(buffer, 4), 4u);
+    BOOST_CHECK_EQUAL(buffer[0], 4);
+    BOOST_CHECK_EQUAL(copy.next_block(buffer, 4), 4u);
+    BOOST_CHECK_EQUAL(buffer[0], 4);
+    BOOST_CHECK_EQUAL(source.next_block(buffer, 4), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(test_reference)
+{
+    std::vector<int> v = make_values();
+    block_range<std::vector<int>::iterator> range(v.begin(), v.end());
+    any<test_concept, _self&> source(range);
+    std::vector<int> out;
+    read_all(source, out);
+    BOOST_CHECK_EQUAL_COLLECTIONS(out.begin(), out.end(), v.begin(), v.end());
+    BOOST_CHECK(range.begin() == range.end());
+}
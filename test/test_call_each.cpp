@@ -0,0 +1,112 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/builtin.hpp>
+#include <boost/type_erasure/callable.hpp>
+#include <boost/type_erasure/call_each.hpp>
+#include <boost/type_erasure/relaxed.hpp>
+#include <boost/type_erasure/operators.hpp>
+#include <boost/type_erasure/any_cast.hpp>
+#include <boost/mpl/vector.hpp>
+#include <vector>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::type_erasure;
+
+template<int N>
+struct tagged
+{
+    explicit tagged(int i) : id(N + i) {}
+    void operator()(std::vector<int>& out) const { out.push_back(id); }
+    int id;
+};
+
+typedef ::boost::mpl::vector<
+    copy_constructible<>,
+    typeid_<>,
+    callable<void(std::vector<int>&), const _self>
+> test_concept;
+
+struct record
+{
+    explicit record(std::vector<int>& o) : out(&o) {}
+    void operator()(const any<test_concept>& arg) const { arg(*out); }
+    std::vector<int>* out;
+};
+
+static std::vector<any<test_concept> > make_elements()
+{
+    std::vector<any<test_concept> > result;
+    result.push_back(any<test_concept>(tagged<0>(0)));
+    result.push_back(any<test_concept>(tagged<100>(0)));
+    result.push_back(any<test_concept>(tagged<0>(1)));
+    result.push_back(any<test_concept>(tagged<100>(1)));
+    result.push_back(any<test_concept>(tagged<0>(2)));
+    return result;
+}
+
+static std::vector<int> expected()
+{
+    std::vector<int> result;
+    result.push_back(0);
+    result.push_back(1);
+    result.push_back(2);
+    result.push_back(100);
+    result.push_back(101);
+    return result;
+}
+
+BOOST_AUTO_TEST_CASE(test_for_each_grouped)
+{
+    std::vector<any<test_concept> > elements = make_elements();
+    std::vector<int> out;
+    for_each_grouped(elements.begin(), elements.end(), record(out));
+    std::vector<int> expect = expected();
+    BOOST_CHECK_EQUAL_COLLECTIONS(out.begin(), out.end(), expect.begin(), expect.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_empty)
+{
+    std::vector<any<test_concept> > elements;
+    std::vector<int> out;
+    for_each_grouped(elements.begin(), elements.end(), record(out));
+    BOOST_CHECK(out.empty());
+}
+
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+
+BOOST_AUTO_TEST_CASE(test_call_each)
+{
+    const std::vector<any<test_concept> > elements = make_elements();
+    std::vector<int> out;
+    call_each(callable<void(std::vector<int>&), const _self>(), elements, out);
+    std::vector<int> expect = expected();
+    BOOST_CHECK_EQUAL_COLLECTIONS(out.begin(), out.end(), expect.begin(), expect.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_call_each_ref)
+{
+    typedef ::boost::mpl::vector<copy_constructible<>, incrementable<>, typeid_<>, relaxed> concept_type;
+    std::vector<any<concept_type> > elements;
+    elements.push_back(any<concept_type>(1));
+    elements.push_back(any<concept_type>(1.5));
+    elements.push_back(any<concept_type>(2));
+    call_each(incrementable<>(), elements);
+    BOOST_CHECK_EQUAL(any_cast<int>(elements[0]), 2);
+    BOOST_CHECK_EQUAL(any_cast<double>(elements[1]), 2.5);
+    BOOST_CHECK_EQUAL(any_cast<int>(elements[2]), 3);
+    elements.push_back(any<concept_type>());
+    BOOST_CHECK_THROW(call_each(incrementable<>(), elements), bad_function_call);
+}
+
+#endif
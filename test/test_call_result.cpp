@@ -0,0 +1,336 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/builtin.hpp>
+#include <boost/type_erasure/operators.hpp>
+#include <boost/type_erasure/callable.hpp>
+#include <boost/type_erasure/any_cast.hpp>
+#include <boost/type_erasure/call.hpp>
+#include <boost/type_erasure/relaxed.hpp>
+#include <boost/type_erasure/small_buffer.hpp>
+#include <boost/type_erasure/intrusive.hpp>
+#include <boost/type_erasure/copy_on_write.hpp>
+#include <boost/mpl/vector.hpp>
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <utility>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include "allocation_counter.hpp"
+
+using namespace boost::type_erasure;
+
+template<class T = _self>
+struct arithmetic : ::boost::mpl::vector<
+    copy_constructible<T>,
+    typeid_<T>,
+    addable<T>,
+    negatable<T>,
+    relaxed
+> {};
+
+typedef ::boost::mpl::vector<arithmetic<>, small_buffer<> > buffered_concept;
+typedef ::boost::mpl::vector<arithmetic<>, intrusive> intrusive_concept;
+
+template<class Any>
+bool is_inline(const Any& arg)
+{
+    const char* p = static_cast<const char*>(any_cast<const void*>(&arg));
+    const char* first = reinterpret_cast<const char*>(&arg);
+    return p >= first && p < first + sizeof(Any);
+}
+
+struct big
+{
+    big(int v = 0) { value[0] = v; }
+    int value[32];
+};
+
+big operator+(const big& lhs, const big& rhs) { return big(lhs.value[0] + rhs.value[0]); }
+big operator-(const big& arg) { return big(-arg.value[0]); }
+
+// Adding throws if the sum would be negative.
+struct checked
+{
+    checked(int v = 0) : value(v) {}
+    int value;
+};
+
+checked operator+(const checked& lhs, const checked& rhs)
+{
+    if(lhs.value + rhs.value < 0) throw std::exception();
+    return checked(lhs.value + rhs.value);
+}
+checked operator-(const checked& arg) { return checked(-arg.value); }
+
+struct twice
+{
+    int operator()(int i) const { return 2 * i; }
+};
+
+// Moving may throw, so a result cannot replace an old object.
+struct fragile
+{
+    fragile(int v = 0) : value(v) {}
+    fragile(const fragile& other) : value(other.value) {}
+    int value;
+};
+
+fragile operator+(const fragile& lhs, const fragile& rhs) { return fragile(lhs.value + rhs.value); }
+fragile operator-(const fragile& arg) { return fragile(-arg.value); }
+
+BOOST_AUTO_TEST_CASE(test_result)
+{
+    typedef ::boost::mpl::vector<arithmetic<> > test_concept;
+    any<test_concept> x(1);
+    any<test_concept> y(2);
+    any<test_concept> z(x + y);
+    BOOST_CHECK_EQUAL(any_cast<int>(z), 3);
+    z = -z;
+    BOOST_CHECK_EQUAL(any_cast<int>(z), -3);
+    BOOST_CHECK_EQUAL(any_cast<int>(x), 1);
+    BOOST_CHECK_EQUAL(any_cast<int>(y), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_reference_result)
+{
+    typedef ::boost::mpl::vector<
+        copy_constructible<>,
+        typeid_<>,
+        add_assignable<>
+    > test_concept;
+    any<test_concept> x(1);
+    any<test_concept> y(2);
+    any<test_concept, _self&> z(x += y);
+    BOOST_CHECK_EQUAL(any_cast<int*>(&z), any_cast<int*>(&x));
+    BOOST_CHECK_EQUAL(any_cast<int>(x), 3);
+}
+
+#ifdef BOOST_TYPE_ERASURE_SFINAE_FRIENDLY_CONSTRUCTORS
+
+BOOST_AUTO_TEST_CASE(test_small_buffer)
+{
+    any<buffered_concept> x(1);
+    any<buffered_concept> y(2);
+    std::size_t before = allocations;
+    any<buffered_concept> z(x + y);
+    BOOST_CHECK_EQUAL(allocations, before);
+    BOOST_CHECK(is_inline(z));
+    BOOST_CHECK_EQUAL(any_cast<int>(z), 3);
+    z = -z;
+    BOOST_CHECK_EQUAL(allocations, before);
+    BOOST_CHECK_EQUAL(any_cast<int>(z), -3);
+    z = z + x;
+    BOOST_CHECK_EQUAL(allocations, before);
+    BOOST_CHECK_EQUAL(any_cast<int>(z), -2);
+}
+
+BOOST_AUTO_TEST_CASE(test_small_buffer_too_big)
+{
+    any<buffered_concept> x((big(1)));
+    any<buffered_concept> y((big(2)));
+    std::size_t before = allocations;
+    any<buffered_concept> z(x + y);
+    BOOST_CHECK_EQUAL(allocations, before + 1);
+    BOOST_CHECK(!is_inline(z));
+    BOOST_CHECK_EQUAL(any_cast<const big&>(z).value[0], 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_callable)
+{
+    typedef ::boost::mpl::vector<
+        copy_constructible<>,
+        typeid_<>,
+        callable<_a(const _a&), const _self>,
+        copy_constructible<_a>,
+        typeid_<_a>,
+        small_buffer<>
+    > test_concept;
+    typedef ::boost::mpl::map<
+        ::boost::mpl::pair<_self, twice>,
+        ::boost::mpl::pair<_a, int>
+    > types;
+    any<test_concept> f(twice(), make_binding<types>());
+    any<test_concept, _a> i(21, make_binding<types>());
+    std::size_t before = allocations;
+    any<test_concept, _a> result(f(i));
+    BOOST_CHECK_EQUAL(allocations, before);
+    BOOST_CHECK(is_inline(result));
+    BOOST_CHECK_EQUAL(any_cast<int>(result), 42);
+}
+
+BOOST_AUTO_TEST_CASE(test_guarded)
+{
+    any<buffered_concept> x(1);
+    any<buffered_concept> y(2);
+    std::size_t before = allocations;
+    any<buffered_concept> z(guarded_call<int>(addable<>(), x, y));
+    BOOST_CHECK_EQUAL(allocations, before);
+    BOOST_CHECK(is_inline(z));
+    BOOST_CHECK_EQUAL(any_cast<int>(z), 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_intrusive)
+{
+    any<intrusive_concept> x(1);
+    any<intrusive_concept> y(2);
+    std::size_t before = allocations;
+    any<intrusive_concept> z(x + y);
+    // The binding and the result share one block.
+    BOOST_CHECK_EQUAL(allocations, before + 1);
+    BOOST_CHECK_EQUAL(any_cast<int>(z), 3);
+    z = -z;
+    BOOST_CHECK_EQUAL(any_cast<int>(z), -3);
+}
+
+template<class Concept>
+void check_assign_result()
+{
+    any<Concept> x(std::string("abc"));
+    any<Concept> y(std::string("def"));
+    any<Concept> z(x);
+    z = x + y;
+    BOOST_CHECK_EQUAL(any_cast<const std::string&>(z), "abcdef");
+    z = z + z;
+    BOOST_CHECK_EQUAL(any_cast<const std::string&>(z), "abcdefabcdef");
+    any<Concept>& self = z;
+    z = std::move(self);
+    BOOST_CHECK_EQUAL(any_cast<const std::string&>(z), "abcdefabcdef");
+    any<Concept> w(1);
+    z = std::move(w);
+    BOOST_CHECK_EQUAL(any_cast<int>(z), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_assign_result)
+{
+    typedef ::boost::mpl::vector<
+        copy_constructible<>,
+        typeid_<>,
+        addable<>,
+        relaxed
+    > heap_concept;
+    check_assign_result<heap_concept>();
+    check_assign_result< ::boost::mpl::vector<heap_concept, small_buffer<sizeof(std::string)> > >();
+    check_assign_result< ::boost::mpl::vector<heap_concept, intrusive> >();
+}
+
+BOOST_AUTO_TEST_CASE(test_call_into)
+{
+    typedef ::boost::mpl::vector<arithmetic<> > heap_concept;
+    any<heap_concept> x(1.5);
+    any<heap_concept> y(2.0);
+    any<heap_concept> z(0.0);
+    const void* address = any_cast<const void*>(&z);
+    std::size_t before = allocations;
+    for(int i = 0; i < 10; ++i) {
+        call_into(z, addable<>(), z, y);
+    }
+    BOOST_CHECK_EQUAL(allocations, before);
+    BOOST_CHECK_EQUAL(any_cast<const void*>(&z), address);
+    BOOST_CHECK_EQUAL(any_cast<double>(z), 20.0);
+    call_into(z, negatable<>(), x);
+    BOOST_CHECK_EQUAL(allocations, before);
+    BOOST_CHECK_EQUAL(any_cast<double>(z), -1.5);
+
+    // A result of another type replaces the any.
+    any<heap_concept> i(1);
+    call_into(z, addable<>(), i, i);
+    BOOST_CHECK_EQUAL(any_cast<int>(z), 2);
+    any<heap_concept> empty;
+    call_into(empty, addable<>(), x, y);
+    BOOST_CHECK_EQUAL(any_cast<double>(empty), 3.5);
+
+    // The result does not have to be an any.
+    typedef ::boost::mpl::vector<
+        copy_constructible<>,
+        callable<int(int), const _self>
+    > function_concept;
+    any<function_concept> f((twice()));
+    int result = 0;
+    call_into(result, callable<int(int), const _self>(), f, 21);
+    BOOST_CHECK_EQUAL(result, 42);
+}
+
+BOOST_AUTO_TEST_CASE(test_call_into_string)
+{
+    typedef ::boost::mpl::vector<
+        copy_constructible<>,
+        typeid_<>,
+        addable<>,
+        relaxed
+    > heap_concept;
+    any<heap_concept> x(std::string("abc"));
+    any<heap_concept> z(std::string("def"));
+    const void* address = any_cast<const void*>(&z);
+    call_into(z, addable<>(), x, z);
+    BOOST_CHECK_EQUAL(any_cast<const void*>(&z), address);
+    BOOST_CHECK_EQUAL(any_cast<const std::string&>(z), "abcdef");
+    call_into(z, addable<>(), z, z);
+    BOOST_CHECK_EQUAL(any_cast<const std::string&>(z), "abcdefabcdef");
+    BOOST_CHECK_EQUAL(any_cast<const std::string&>(x), "abc");
+}
+
+BOOST_AUTO_TEST_CASE(test_call_into_intrusive)
+{
+    any<intrusive_concept> x(1);
+    any<intrusive_concept> z(0);
+    std::size_t before = allocations;
+    call_into(z, addable<>(), x, x);
+    BOOST_CHECK_EQUAL(allocations, before);
+    BOOST_CHECK_EQUAL(any_cast<int>(z), 2);
+
+    // A shared object is left alone.
+    typedef ::boost::mpl::vector<arithmetic<>, copy_on_write> shared_concept;
+    any<shared_concept> y(1);
+    any<shared_concept> w(0);
+    any<shared_concept> copy(w);
+    call_into(w, addable<>(), y, y);
+    BOOST_CHECK_EQUAL(any_cast<int>(w), 2);
+    BOOST_CHECK_EQUAL(any_cast<int>(copy), 0);
+    call_into(w, addable<>(), w, y);
+    BOOST_CHECK_EQUAL(any_cast<int>(w), 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_call_into_fragile)
+{
+    typedef ::boost::mpl::vector<arithmetic<> > heap_concept;
+    any<heap_concept> x((fragile(1)));
+    any<heap_concept> z((fragile(2)));
+    call_into(z, addable<>(), x, z);
+    BOOST_CHECK_EQUAL(any_cast<const fragile&>(z).value, 3);
+    call_into(z, negatable<>(), z);
+    BOOST_CHECK_EQUAL(any_cast<const fragile&>(z).value, -3);
+}
+
+BOOST_AUTO_TEST_CASE(test_call_into_exception)
+{
+    typedef ::boost::mpl::vector<arithmetic<> > heap_concept;
+    any<heap_concept> x((checked(1)));
+    any<heap_concept> z((checked(-2)));
+    BOOST_CHECK_THROW(call_into(z, addable<>(), x, z), std::exception);
+    BOOST_CHECK_EQUAL(any_cast<const checked&>(z).value, -2);
+}
+
+BOOST_AUTO_TEST_CASE(test_exception)
+{
+    any<buffered_concept> x((checked(1)));
+    any<buffered_concept> y((checked(-2)));
+    BOOST_CHECK_THROW(any<buffered_concept>(x + y), std::exception);
+    any<intrusive_concept> ix((checked(1)));
+    any<intrusive_concept> iy((checked(-2)));
+    BOOST_CHECK_THROW(any<intrusive_concept>(ix + iy), std::exception);
+    BOOST_CHECK_EQUAL(any_cast<const checked&>(x).value, 1);
+}
+
+#endif
@@ -0,0 +1,91 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/builtin.hpp>
+#include <boost/type_erasure/operators.hpp>
+#include <boost/type_erasure/any_cast.hpp>
+#include <boost/type_erasure/binding_of.hpp>
+#include <boost/type_erasure/closed.hpp>
+#include <boost/type_erasure/relaxed.hpp>
+#include <boost/type_erasure/tuple.hpp>
+#include <boost/mpl/vector.hpp>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::type_erasure;
+
+template<class T = _self>
+struct common : ::boost::mpl::vector<
+    copy_constructible<T>,
+    typeid_<T>
+> {};
+
+typedef ::boost::mpl::vector<int, double, long> closed_types;
+
+typedef ::boost::mpl::vector<
+    common<>,
+    addable<>,
+    incrementable<>,
+    closed<closed_types>
+> test_concept;
+
+BOOST_AUTO_TEST_CASE(test_index)
+{
+    BOOST_CHECK_EQUAL((closed<closed_types, int>::value()), 0u);
+    BOOST_CHECK_EQUAL((closed<closed_types, long>::value()), 2u);
+    BOOST_CHECK_EQUAL((closed<closed_types, void>::value()), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(test_call)
+{
+    any<test_concept> x(1);
+    ++x;
+    BOOST_CHECK_EQUAL(any_cast<int>(x), 2);
+    any<test_concept> y(x + x);
+    BOOST_CHECK_EQUAL(any_cast<int>(y), 4);
+    any<test_concept> z(1.5);
+    ++z;
+    BOOST_CHECK_EQUAL(any_cast<double>(z), 2.5);
+    any<test_concept> w(z);
+    BOOST_CHECK_EQUAL(any_cast<double>(w), 2.5);
+}
+
+BOOST_AUTO_TEST_CASE(test_binding)
+{
+    any<test_concept> x(1.5);
+    BOOST_CHECK_EQUAL(::boost::type_erasure::detail::get_closed_index<
+        closed<closed_types> >(binding_of(x)), 1u);
+}
+
+// Other placeholders are dispatched through the vtable.
+BOOST_AUTO_TEST_CASE(test_other_placeholder)
+{
+    typedef ::boost::mpl::vector<
+        common<_a>,
+        common<_b>,
+        addable<_a, _b, _a>,
+        closed< ::boost::mpl::vector<int, double>, _a>
+    > concept_type;
+    tuple<concept_type, _a, _b> t(1.5, 2);
+    any<concept_type, _a> x(get<0>(t) + get<1>(t));
+    BOOST_CHECK_EQUAL(any_cast<double>(x), 3.5);
+}
+
+BOOST_AUTO_TEST_CASE(test_null)
+{
+    typedef ::boost::mpl::vector<common<>, incrementable<>, relaxed, closed<closed_types> > relaxed_concept;
+    any<relaxed_concept> x;
+    BOOST_CHECK_THROW(++x, bad_function_call);
+    x = 1;
+    ++x;
+    BOOST_CHECK_EQUAL(any_cast<int>(x), 2);
+}
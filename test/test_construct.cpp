@@ -17,6 +17,7 @@
 #include <boost/mpl/vector.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <vector>
+#include <memory>
 
 #define BOOST_TEST_MAIN
 #include <boost/test/unit_test.hpp>
@@ -296,6 +297,24 @@ struct make_arg_impl<T&&>
     }
 };
 
+// Moving from a relaxed any leaves it empty, so every
+// rvalue has to come from a fresh object.
+template<class Concept>
+struct make_arg_impl<any<Concept, _a>&&>
+{
+    static any<Concept, _a>&& apply()
+    {
+        static std::unique_ptr<any<Concept, _a> > result;
+        result.reset(new any<Concept, _a>(
+            test_class(),
+            make_binding< ::boost::mpl::map<
+                ::boost::mpl::pair<_a, test_class>,
+                ::boost::mpl::pair<_b, int>
+        > >()));
+        return std::move(*result);
+    }
+};
+
 #endif
 
 #ifdef BOOST_NO_CXX11_RVALUE_REFERENCES
@@ -435,7 +454,14 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_construct1, extra, maybe_relaxed)
     TEST_CONSTRUCT(_a(_a&), (const binding<C>&, any<C, _a>&), (lvalue | id_copy));
 #endif
 
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    // Moving a relaxed any takes over the stored object
+    // instead of constructing a new one.
+    TEST_CONSTRUCT(_a(const _a&), (any<C, _a>),
+        (::boost::type_erasure::is_relaxed<extra>::value? rvalue | id_copy : const_lvalue | id_copy));
+#else
     TEST_CONSTRUCT(_a(const _a&), (any<C, _a>), (const_lvalue | id_copy));
+#endif
     TEST_CONSTRUCT(_a(const _a&), (any<C, _a>&), (const_lvalue | id_copy));
     TEST_CONSTRUCT(_a(const _a&), (const any<C, _a>&), (const_lvalue | id_copy));
     TEST_CONSTRUCT(_a(const _a&), (binding<C>, any<C, _a>), (const_lvalue | id_copy));
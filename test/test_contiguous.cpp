@@ -0,0 +1,113 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/builtin.hpp>
+#include <boost/type_erasure/operators.hpp>
+#include <boost/type_erasure/iterator.hpp>
+#include <boost/type_erasure/same_type.hpp>
+#include <boost/mpl/vector.hpp>
+#include <deque>
+#include <list>
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::type_erasure;
+
+typedef boost::mpl::vector<
+    random_access_iterator<>,
+    same_type<random_access_iterator<>::value_type, int>,
+    contiguous_iterator<int>
+> iterator_concept;
+
+BOOST_AUTO_TEST_CASE(test_iterator)
+{
+    std::vector<int> vec(10);
+    any<iterator_concept> x(vec.begin() + 2);
+    BOOST_CHECK_EQUAL(x.contiguous_data(), &vec[2]);
+    int arr[3] = { 1, 2, 3 };
+    any<iterator_concept> y(&arr[1]);
+    BOOST_CHECK_EQUAL(y.contiguous_data(), &arr[1]);
+}
+
+BOOST_AUTO_TEST_CASE(test_const_iterator)
+{
+    typedef boost::mpl::vector<
+        random_access_iterator<_self, const int&>,
+        same_type<random_access_iterator<_self, const int&>::value_type, int>,
+        contiguous_iterator<int>
+    > const_concept;
+    const std::vector<int> vec(10);
+    any<const_concept> x(vec.begin());
+    BOOST_CHECK_EQUAL(x.contiguous_data(), &vec[0]);
+}
+
+BOOST_AUTO_TEST_CASE(test_iterator_fallback)
+{
+    std::deque<int> d(10);
+    any<iterator_concept> x(d.begin());
+    BOOST_CHECK(x.contiguous_data() == 0);
+    typedef boost::mpl::vector<
+        bidirectional_iterator<>,
+        same_type<bidirectional_iterator<>::value_type, int>,
+        contiguous_iterator<int>
+    > list_concept;
+    std::list<int> l(10);
+    any<list_concept> y(l.begin());
+    BOOST_CHECK(y.contiguous_data() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_string_iterator)
+{
+    typedef boost::mpl::vector<
+        random_access_iterator<>,
+        same_type<random_access_iterator<>::value_type, char>,
+        contiguous_iterator<char>
+    > char_concept;
+    std::string s("abc");
+    any<char_concept> x(s.begin() + 1);
+    BOOST_CHECK_EQUAL(static_cast<const void*>(x.contiguous_data()), static_cast<const void*>(&s[1]));
+}
+
+typedef boost::mpl::vector<
+    copy_constructible<>,
+    contiguous_range<int>
+> range_concept;
+
+BOOST_AUTO_TEST_CASE(test_range)
+{
+    std::vector<int> vec(10);
+    any<range_concept, _self&> x(vec);
+    BOOST_CHECK_EQUAL(x.contiguous_data(), &vec[0]);
+    BOOST_CHECK_EQUAL(x.contiguous_size(), 10u);
+    any<range_concept> y(vec);
+    BOOST_CHECK(y.contiguous_data() != 0);
+    BOOST_CHECK(y.contiguous_data() != &vec[0]);
+    BOOST_CHECK_EQUAL(y.contiguous_size(), 10u);
+    int arr[3] = { 1, 2, 3 };
+    any<contiguous_range<int>, _self&> z(arr);
+    BOOST_CHECK_EQUAL(z.contiguous_data(), &arr[0]);
+    BOOST_CHECK_EQUAL(z.contiguous_size(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(test_range_fallback)
+{
+    std::list<int> l(10);
+    any<range_concept, _self&> x(l);
+    BOOST_CHECK(x.contiguous_data() == 0);
+    BOOST_CHECK_EQUAL(x.contiguous_size(), 0u);
+    typedef boost::mpl::vector<copy_constructible<>, contiguous_range<bool> > bool_concept;
+    std::vector<bool> b(10);
+    any<bool_concept, _self&> y(b);
+    BOOST_CHECK(y.contiguous_data() == 0);
+}
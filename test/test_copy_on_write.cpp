@@ -0,0 +1,149 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/builtin.hpp>
+#include <boost/type_erasure/operators.hpp>
+#include <boost/type_erasure/any_cast.hpp>
+#include <boost/type_erasure/relaxed.hpp>
+#include <boost/type_erasure/copy_on_write.hpp>
+#include <boost/mpl/vector.hpp>
+#include <vector>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::type_erasure;
+
+template<class T = _self>
+struct common : ::boost::mpl::vector<
+    copy_constructible<T>,
+    typeid_<T>
+> {};
+
+typedef ::boost::mpl::vector<common<>, relaxed, copy_on_write> shared_concept;
+
+int instances = 0;
+int copies = 0;
+
+struct big
+{
+    big(int v = 0) { value[0] = v; ++instances; }
+    big(const big& other) { value[0] = other.value[0]; ++instances; ++copies; }
+    ~big() { --instances; }
+    int value[32];
+};
+
+BOOST_AUTO_TEST_CASE(test_value)
+{
+    {
+        any<shared_concept> x(big(1));
+        BOOST_CHECK_EQUAL(any_cast<big&>(x).value[0], 1);
+        any<shared_concept> y(x);
+        BOOST_CHECK_EQUAL(any_cast<const big&>(y).value[0], 1);
+        x = any<shared_concept>(2);
+        BOOST_CHECK_EQUAL(any_cast<int>(x), 2);
+        BOOST_CHECK_EQUAL(instances, 1);
+    }
+    BOOST_CHECK_EQUAL(instances, 0);
+}
+
+#ifdef BOOST_TYPE_ERASURE_SFINAE_FRIENDLY_CONSTRUCTORS
+
+BOOST_AUTO_TEST_CASE(test_size)
+{
+    BOOST_CHECK_EQUAL(sizeof(any<shared_concept>), sizeof(void*));
+}
+
+BOOST_AUTO_TEST_CASE(test_copy_shares)
+{
+    {
+        const any<shared_concept> x(big(3));
+        copies = 0;
+        std::vector<any<shared_concept> > subscribers(50, x);
+        any<shared_concept> y(subscribers[0]);
+        BOOST_CHECK_EQUAL(copies, 0);
+        BOOST_CHECK_EQUAL(instances, 1);
+        BOOST_CHECK_EQUAL(&any_cast<const big&>(x), &any_cast<const big&>(y));
+    }
+    BOOST_CHECK_EQUAL(instances, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_write_copies)
+{
+    {
+        any<shared_concept> x(big(4));
+        any<shared_concept> y(x);
+        copies = 0;
+        any_cast<big&>(y).value[0] = 5;
+        BOOST_CHECK_EQUAL(copies, 1);
+        BOOST_CHECK_EQUAL(any_cast<const big&>(x).value[0], 4);
+        BOOST_CHECK_EQUAL(any_cast<const big&>(y).value[0], 5);
+        // y is no longer shared.
+        any_cast<big&>(y).value[0] = 6;
+        BOOST_CHECK_EQUAL(copies, 1);
+        // Neither is x, since y has its own copy.
+        any_cast<big&>(x).value[0] = 7;
+        BOOST_CHECK_EQUAL(copies, 1);
+        BOOST_CHECK_EQUAL(instances, 2);
+    }
+    BOOST_CHECK_EQUAL(instances, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_write_after_copy_destroyed)
+{
+    any<shared_concept> x(big(8));
+    {
+        any<shared_concept> y(x);
+    }
+    copies = 0;
+    any_cast<big&>(x).value[0] = 9;
+    BOOST_CHECK_EQUAL(copies, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_move)
+{
+    typedef ::boost::mpl::vector<common<>, copy_on_write> test_concept;
+    {
+        any<test_concept> x(big(10));
+        copies = 0;
+        any<test_concept> y(std::move(x));
+        BOOST_CHECK_EQUAL(copies, 0);
+        BOOST_CHECK_EQUAL(any_cast<const big&>(y).value[0], 10);
+    }
+    BOOST_CHECK_EQUAL(instances, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_empty)
+{
+    any<shared_concept> x;
+    any<shared_concept> y(x);
+    BOOST_CHECK(any_cast<int*>(&y) == 0);
+    y = 11;
+    x = y;
+    BOOST_CHECK_EQUAL(any_cast<int>(x), 11);
+}
+
+// Calls through a const any do not copy.
+BOOST_AUTO_TEST_CASE(test_const_call)
+{
+    typedef ::boost::mpl::vector<common<>, addable<>, add_assignable<>, copy_on_write> test_concept;
+    any<test_concept> x(12);
+    any<test_concept> y(x);
+    const any<test_concept>& cy = y;
+    any<test_concept> z(x + cy);
+    BOOST_CHECK_EQUAL(&any_cast<const int&>(x), &any_cast<const int&>(y));
+    BOOST_CHECK_EQUAL(any_cast<int>(z), 24);
+    y += z;
+    BOOST_CHECK_EQUAL(any_cast<int>(x), 12);
+    BOOST_CHECK_EQUAL(any_cast<int>(y), 36);
+}
+
+#endif
@@ -15,6 +15,8 @@
 #include <boost/type_erasure/any_cast.hpp>
 #include <boost/mpl/vector.hpp>
 #include <boost/mpl/map.hpp>
+#include <boost/mpl/range_c.hpp>
+#include <boost/mpl/for_each.hpp>
 
 #define BOOST_TEST_MAIN
 #include <boost/test/unit_test.hpp>
@@ -263,3 +265,121 @@ BOOST_AUTO_TEST_CASE(test_rref)
 }
 
 #endif
+
+template<int N>
+struct numbered
+{
+    numbered() : value(N) {}
+    int value;
+};
+
+struct register_numbered
+{
+    template<class N>
+    void operator()(N)
+    {
+        register_binding<common<>, numbered<N::value> >();
+    }
+};
+
+struct check_numbered
+{
+    template<class N>
+    void operator()(N)
+    {
+        typedef any< ::boost::mpl::vector<common<>, relaxed> > relaxed_any;
+        any<common<> > x((numbered<N::value>()));
+        relaxed_any y = dynamic_any_cast<relaxed_any>(x);
+        BOOST_CHECK_EQUAL(any_cast<const numbered<N::value>&>(y).value, N::value);
+    }
+};
+
+// enough bindings to make the registry grow several times
+BOOST_AUTO_TEST_CASE(test_many_bindings)
+{
+    typedef ::boost::mpl::range_c<int, 0, 100> numbers;
+    ::boost::mpl::for_each<numbers>(register_numbered());
+    ::boost::mpl::for_each<numbers>(check_numbered());
+}
+
+// Converted bindings are cached by the types involved,
+// so the same cast must still work for different types.
+BOOST_AUTO_TEST_CASE(test_cached_conversion)
+{
+    register_binding<common<>, double>();
+    register_binding<incrementable<>, double>();
+    typedef any< ::boost::mpl::vector<common<>, incrementable<> > > incrementable_any;
+    for(int i = 0; i < 2; ++i) {
+        any<common<> > x(1);
+        incrementable_any y = dynamic_any_cast<incrementable_any>(x);
+        ++y;
+        BOOST_CHECK_EQUAL(any_cast<int>(y), 2);
+        any<common<> > z(1.5);
+        incrementable_any w = dynamic_any_cast<incrementable_any>(z);
+        ++w;
+        BOOST_CHECK_EQUAL(any_cast<double>(w), 2.5);
+    }
+}
+
+struct late_registered
+{
+    late_registered() : value(0) {}
+    late_registered& operator++() { ++value; return *this; }
+    int value;
+};
+
+// A failed conversion is not cached.
+BOOST_AUTO_TEST_CASE(test_register_after_failure)
+{
+    typedef any< ::boost::mpl::vector<common<>, incrementable<> > > incrementable_any;
+    any<common<> > x((late_registered()));
+    BOOST_CHECK_THROW(dynamic_any_cast<incrementable_any>(x), bad_any_cast);
+    register_binding<common<>, late_registered>();
+    register_binding<incrementable<>, late_registered>();
+    incrementable_any y = dynamic_any_cast<incrementable_any>(x);
+    ++y;
+    BOOST_CHECK_EQUAL(any_cast<late_registered&>(y).value, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_try_cast)
+{
+    typedef any< ::boost::mpl::vector<common<>, incrementable<> > > incrementable_any;
+    any<common<> > x(1);
+    boost::optional<incrementable_any> y = try_dynamic_any_cast<incrementable_any>(x);
+    BOOST_REQUIRE(y);
+    ++*y;
+    BOOST_CHECK_EQUAL(any_cast<int>(*y), 2);
+    any<common<> > z("42");
+    BOOST_CHECK(!try_dynamic_any_cast<incrementable_any>(z));
+}
+
+BOOST_AUTO_TEST_CASE(test_try_cast_ref)
+{
+    typedef any< ::boost::mpl::vector<common<>, incrementable<> >, _self&> incrementable_ref;
+    any<common<> > x(1);
+    boost::optional<incrementable_ref> y = try_dynamic_any_cast<incrementable_ref>(x);
+    BOOST_REQUIRE(y);
+    ++*y;
+    BOOST_CHECK_EQUAL(any_cast<int>(x), 2);
+    any<common<> > z("42");
+    BOOST_CHECK(!try_dynamic_any_cast<incrementable_ref>(z));
+}
+
+BOOST_AUTO_TEST_CASE(test_try_cast_placeholder)
+{
+    typedef any< ::boost::mpl::vector<common<_a>, incrementable<_a> >, _a> incrementable_any;
+    any<common<> > x(1);
+    boost::optional<incrementable_any> y = try_dynamic_any_cast<incrementable_any>(x);
+    BOOST_REQUIRE(y);
+    ++*y;
+    BOOST_CHECK_EQUAL(any_cast<int>(*y), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_is_registered)
+{
+    BOOST_CHECK((is_registered<common<>, int>()));
+    BOOST_CHECK((is_registered< ::boost::mpl::vector<common<>, incrementable<> >, int>()));
+    BOOST_CHECK((!is_registered<incrementable<>, const char*>()));
+    BOOST_CHECK((!is_registered< ::boost::mpl::vector<common<>, decrementable<> >, int>()));
+    BOOST_CHECK((is_registered<addable<_self, _self, _a> >(make_binding<boost::mpl::map<boost::mpl::pair<_self, int>, boost::mpl::pair<_a, int> > >())));
+}
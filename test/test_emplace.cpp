@@ -0,0 +1,212 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/builtin.hpp>
+#include <boost/type_erasure/any_cast.hpp>
+#include <boost/type_erasure/operators.hpp>
+#include <boost/type_erasure/relaxed.hpp>
+#include <boost/type_erasure/in_place.hpp>
+#include <boost/type_erasure/small_buffer.hpp>
+#include <boost/type_erasure/intrusive.hpp>
+#include <boost/type_erasure/copy_on_write.hpp>
+#include <boost/mpl/vector.hpp>
+#include <cstddef>
+#include <exception>
+#include <string>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include "allocation_counter.hpp"
+
+using namespace boost::type_erasure;
+
+template<class T = _self>
+struct common : ::boost::mpl::vector<
+    copy_constructible<T>,
+    typeid_<T>
+> {};
+
+typedef ::boost::mpl::vector<common<>, relaxed> relaxed_concept;
+
+BOOST_AUTO_TEST_CASE(test_is_in_place_arg)
+{
+    BOOST_CHECK(::boost::type_erasure::detail::is_in_place_arg<in_place_type_t<int> >::value);
+    BOOST_CHECK(::boost::type_erasure::detail::is_in_place_arg<const in_place_type_t<int>&>::value);
+    BOOST_CHECK(!::boost::type_erasure::detail::is_in_place_arg<int>::value);
+}
+
+#ifdef BOOST_TYPE_ERASURE_SFINAE_FRIENDLY_CONSTRUCTORS
+
+struct point
+{
+    point(int x_arg, int y_arg) : x(x_arg), y(y_arg) {}
+    int x;
+    int y;
+};
+
+// Construction may throw, but moving does not.
+struct checked
+{
+    explicit checked(int v) : value(v) { if(v < 0) throw std::exception(); }
+    checked(const checked& other) : value(other.value) {}
+    checked(checked&& other) BOOST_NOEXCEPT : value(other.value) {}
+    int value;
+};
+
+// Nothing is known not to throw.
+struct fragile
+{
+    explicit fragile(int v) : value(v) { if(v < 0) throw std::exception(); }
+    fragile(const fragile& other) : value(other.value) {}
+    int value;
+};
+
+BOOST_AUTO_TEST_CASE(test_in_place)
+{
+    any<common<> > x(in_place_type_t<std::string>(), 3u, 'a');
+    BOOST_CHECK_EQUAL(any_cast<std::string&>(x), "aaa");
+    any<common<> > y(in_place_type_t<point>(), 1, 2);
+    BOOST_CHECK_EQUAL(any_cast<point&>(y).y, 2);
+    any<common<> > z(y);
+    BOOST_CHECK_EQUAL(any_cast<point&>(z).x, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_in_place_small_buffer)
+{
+    typedef ::boost::mpl::vector<common<>, small_buffer<> > test_concept;
+    std::size_t before = allocations;
+    any<test_concept> x(in_place_type_t<point>(), 3, 4);
+    BOOST_CHECK_EQUAL(allocations, before);
+    BOOST_CHECK_EQUAL(any_cast<point&>(x).x, 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_in_place_intrusive)
+{
+    typedef ::boost::mpl::vector<common<>, intrusive> test_concept;
+    std::size_t before = allocations;
+    any<test_concept> x(in_place_type_t<point>(), 5, 6);
+    BOOST_CHECK_EQUAL(allocations, before + 1);
+    BOOST_CHECK_EQUAL(any_cast<point&>(x).y, 6);
+}
+
+BOOST_AUTO_TEST_CASE(test_emplace_same_type)
+{
+    any<relaxed_concept> x(point(1, 2));
+    point* p = &any_cast<point&>(x);
+    std::size_t before = allocations;
+    point& result = x.emplace<point>(7, 8);
+    BOOST_CHECK_EQUAL(allocations, before);
+    BOOST_CHECK_EQUAL(&result, p);
+    BOOST_CHECK_EQUAL(any_cast<point&>(x).x, 7);
+}
+
+BOOST_AUTO_TEST_CASE(test_emplace_other_type)
+{
+    any<relaxed_concept> x(point(1, 2));
+    std::string& result = x.emplace<std::string>(2u, 'b');
+    BOOST_CHECK_EQUAL(result, "bb");
+    BOOST_CHECK_EQUAL(&any_cast<std::string&>(x), &result);
+    any<relaxed_concept> y;
+    y.emplace<int>(3);
+    BOOST_CHECK_EQUAL(any_cast<int>(y), 3);
+}
+
+// The storage is only reused when the any holds a U, which a
+// table converted from another binding still records.
+BOOST_AUTO_TEST_CASE(test_emplace_converted)
+{
+    typedef ::boost::mpl::vector<common<>, relaxed, addable<> > source_concept;
+    any<source_concept> source(std::string("abc"));
+    any<relaxed_concept> x(source);
+    std::string* p = &any_cast<std::string&>(x);
+    std::size_t before = allocations;
+    x.emplace<std::string>(2u, 'c');
+    BOOST_CHECK_EQUAL(allocations, before);
+    BOOST_CHECK_EQUAL(&any_cast<std::string&>(x), p);
+    BOOST_CHECK_EQUAL(any_cast<std::string&>(x), "cc");
+    x.emplace<point>(1, 2);
+    BOOST_CHECK_EQUAL(any_cast<point&>(x).y, 2);
+}
+
+// Assigning a value of the same type reuses the storage.
+BOOST_AUTO_TEST_CASE(test_assign_same_type)
+{
+    any<relaxed_concept> x(std::string("abc"));
+    std::string* p = &any_cast<std::string&>(x);
+    std::size_t before = allocations;
+    x = std::string("def");
+    BOOST_CHECK_EQUAL(allocations, before);
+    BOOST_CHECK_EQUAL(&any_cast<std::string&>(x), p);
+    BOOST_CHECK_EQUAL(any_cast<std::string&>(x), "def");
+    x = 1;
+    BOOST_CHECK_EQUAL(any_cast<int>(x), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_emplace_throws)
+{
+    any<relaxed_concept> x(checked(1));
+    checked* p = &any_cast<checked&>(x);
+    BOOST_CHECK_THROW(x.emplace<checked>(-1), std::exception);
+    BOOST_CHECK_EQUAL(any_cast<checked&>(x).value, 1);
+    x.emplace<checked>(2);
+    BOOST_CHECK_EQUAL(&any_cast<checked&>(x), p);
+    BOOST_CHECK_EQUAL(any_cast<checked&>(x).value, 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_emplace_not_reusable)
+{
+    any<relaxed_concept> x(fragile(1));
+    BOOST_CHECK_THROW(x.emplace<fragile>(-1), std::exception);
+    BOOST_CHECK_EQUAL(any_cast<fragile&>(x).value, 1);
+    x.emplace<fragile>(2);
+    BOOST_CHECK_EQUAL(any_cast<fragile&>(x).value, 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_emplace_small_buffer)
+{
+    typedef ::boost::mpl::vector<common<>, relaxed, small_buffer<> > test_concept;
+    any<test_concept> x(std::string("abc"));
+    std::size_t before = allocations;
+    x.emplace<point>(1, 2);
+    x.emplace<point>(3, 4);
+    BOOST_CHECK_EQUAL(allocations, before);
+    BOOST_CHECK_EQUAL(any_cast<point&>(x).x, 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_emplace_intrusive)
+{
+    typedef ::boost::mpl::vector<common<>, relaxed, intrusive> test_concept;
+    any<test_concept> x(point(1, 2));
+    point* p = &any_cast<point&>(x);
+    std::size_t before = allocations;
+    x.emplace<point>(3, 4);
+    BOOST_CHECK_EQUAL(allocations, before);
+    BOOST_CHECK_EQUAL(&any_cast<point&>(x), p);
+    BOOST_CHECK_EQUAL(any_cast<point&>(x).y, 4);
+}
+
+// A shared object is left to its other owners.
+BOOST_AUTO_TEST_CASE(test_emplace_copy_on_write)
+{
+    typedef ::boost::mpl::vector<common<>, relaxed, copy_on_write> test_concept;
+    any<test_concept> x(point(1, 2));
+    const any<test_concept> y(x);
+    x.emplace<point>(3, 4);
+    BOOST_CHECK_EQUAL(any_cast<const point&>(x).x, 3);
+    BOOST_CHECK_EQUAL(any_cast<const point&>(y).x, 1);
+    const point* p = &any_cast<const point&>(x);
+    x.emplace<point>(5, 6);
+    BOOST_CHECK_EQUAL(&any_cast<const point&>(x), p);
+    BOOST_CHECK_EQUAL(any_cast<const point&>(x).x, 5);
+}
+
+#endif
@@ -0,0 +1,84 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/builtin.hpp>
+#include <boost/type_erasure/operators.hpp>
+#include <boost/type_erasure/any_cast.hpp>
+#include <boost/type_erasure/binding_of.hpp>
+#include <boost/type_erasure/call.hpp>
+#include <boost/type_erasure/relaxed.hpp>
+#include <boost/mpl/vector.hpp>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::type_erasure;
+
+template<class T = _self>
+struct common : ::boost::mpl::vector<
+    copy_constructible<T>,
+    typeid_<T>
+> {};
+
+typedef ::boost::mpl::vector<
+    common<>,
+    addable<>,
+    incrementable<>
+> test_concept;
+
+BOOST_AUTO_TEST_CASE(test_call)
+{
+    any<test_concept> x(1);
+    call(incrementable<>(), x);
+    BOOST_CHECK_EQUAL(any_cast<int>(x), 2);
+}
+
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+
+BOOST_AUTO_TEST_CASE(test_match)
+{
+    any<test_concept> x(1);
+    guarded_call<int>(incrementable<>(), x);
+    BOOST_CHECK_EQUAL(any_cast<int>(x), 2);
+    any<test_concept> y(guarded_call<int>(addable<>(), x, x));
+    BOOST_CHECK_EQUAL(any_cast<int>(y), 4);
+}
+
+// A wrong guess still calls the right function.
+BOOST_AUTO_TEST_CASE(test_mismatch)
+{
+    any<test_concept> x(1.5);
+    guarded_call<int>(incrementable<>(), x);
+    BOOST_CHECK_EQUAL(any_cast<double>(x), 2.5);
+    any<test_concept> y(guarded_call<int>(addable<>(), x, x));
+    BOOST_CHECK_EQUAL(any_cast<double>(y), 5.0);
+}
+
+BOOST_AUTO_TEST_CASE(test_binding)
+{
+    any<test_concept> x(1);
+    guarded_call<int>(binding_of(x), incrementable<>(), x);
+    BOOST_CHECK_EQUAL(any_cast<int>(x), 2);
+    guarded_call<long>(binding_of(x), incrementable<>(), x);
+    BOOST_CHECK_EQUAL(any_cast<int>(x), 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_relaxed)
+{
+    typedef ::boost::mpl::vector<common<>, addable<>, relaxed> relaxed_concept;
+    any<relaxed_concept> x(1);
+    any<relaxed_concept> y(2.0);
+    BOOST_CHECK_THROW(guarded_call<int>(addable<>(), x, y), bad_function_call);
+    any<relaxed_concept> z;
+    BOOST_CHECK_THROW(guarded_call<int>(addable<>(), z, z), bad_function_call);
+}
+
+#endif
@@ -0,0 +1,161 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/builtin.hpp>
+#include <boost/type_erasure/operators.hpp>
+#include <boost/type_erasure/any_cast.hpp>
+#include <boost/type_erasure/relaxed.hpp>
+#include <boost/type_erasure/intrusive.hpp>
+#include <boost/mpl/vector.hpp>
+#include <cstddef>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include "allocation_counter.hpp"
+
+using namespace boost::type_erasure;
+
+template<class T = _self>
+struct common : ::boost::mpl::vector<
+    copy_constructible<T>,
+    typeid_<T>
+> {};
+
+typedef ::boost::mpl::vector<common<>, relaxed, intrusive> intrusive_concept;
+
+int instances = 0;
+
+struct big
+{
+    big(int v = 0) { value[0] = v; ++instances; }
+    big(const big& other) { value[0] = other.value[0]; ++instances; }
+    ~big() { --instances; }
+    int value[32];
+};
+
+BOOST_AUTO_TEST_CASE(test_value)
+{
+    {
+        any<intrusive_concept> x(big(1));
+        BOOST_CHECK_EQUAL(any_cast<big&>(x).value[0], 1);
+        any<intrusive_concept> y(x);
+        BOOST_CHECK_EQUAL(any_cast<big&>(y).value[0], 1);
+        BOOST_CHECK(&any_cast<big&>(x) != &any_cast<big&>(y));
+        x = any<intrusive_concept>(2);
+        BOOST_CHECK_EQUAL(any_cast<int>(x), 2);
+        BOOST_CHECK_EQUAL(instances, 1);
+    }
+    BOOST_CHECK_EQUAL(instances, 0);
+}
+
+#ifdef BOOST_TYPE_ERASURE_SFINAE_FRIENDLY_CONSTRUCTORS
+
+BOOST_AUTO_TEST_CASE(test_size)
+{
+    BOOST_CHECK_EQUAL(sizeof(any<intrusive_concept>), sizeof(void*));
+}
+
+// The binding and the object share one allocation.
+BOOST_AUTO_TEST_CASE(test_single_allocation)
+{
+    big b(3);
+    std::size_t before = allocations;
+    any<intrusive_concept> x(b);
+    BOOST_CHECK_EQUAL(allocations, before + 1);
+    any<intrusive_concept> y(x);
+    BOOST_CHECK_EQUAL(allocations, before + 2);
+    BOOST_CHECK_EQUAL(any_cast<big&>(y).value[0], 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_move)
+{
+    {
+        any<intrusive_concept> x(big(4));
+        big* p = &any_cast<big&>(x);
+        std::size_t before = allocations;
+        any<intrusive_concept> y(std::move(x));
+        BOOST_CHECK_EQUAL(allocations, before);
+        BOOST_CHECK_EQUAL(&any_cast<big&>(y), p);
+        x = std::move(y);
+        BOOST_CHECK_EQUAL(any_cast<big&>(x).value[0], 4);
+    }
+    BOOST_CHECK_EQUAL(instances, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_move_not_relaxed)
+{
+    typedef ::boost::mpl::vector<common<>, intrusive> test_concept;
+    {
+        any<test_concept> x(big(5));
+        any<test_concept> y(std::move(x));
+        BOOST_CHECK_EQUAL(any_cast<big&>(y).value[0], 5);
+        BOOST_CHECK_EQUAL(any_cast<big&>(x).value[0], 5);
+    }
+    BOOST_CHECK_EQUAL(instances, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_empty)
+{
+    any<intrusive_concept> x;
+    BOOST_CHECK(any_cast<int*>(&x) == 0);
+    any<intrusive_concept> y(6);
+    x = std::move(y);
+    BOOST_CHECK_EQUAL(any_cast<int>(x), 6);
+    y = x;
+    BOOST_CHECK_EQUAL(any_cast<int>(y), 6);
+    any<intrusive_concept> z;
+    x = z;
+    BOOST_CHECK(any_cast<int*>(&x) == 0);
+}
+
+// The result of a call is created with new, and
+// gets a block of its own.
+BOOST_AUTO_TEST_CASE(test_adopt)
+{
+    typedef ::boost::mpl::vector<common<>, addable<>, intrusive> test_concept;
+    any<test_concept> x(7);
+    any<test_concept> y(x + x);
+    BOOST_CHECK_EQUAL(any_cast<int>(y), 14);
+    any<test_concept> z(y);
+    BOOST_CHECK_EQUAL(any_cast<int>(z), 14);
+}
+
+// new respects alignas since C++17.
+#ifdef __cpp_aligned_new
+
+struct alignas(64) over_aligned
+{
+    over_aligned(int v = 0) : value(v) {}
+    int value;
+};
+
+BOOST_AUTO_TEST_CASE(test_over_aligned)
+{
+    any<intrusive_concept> x(over_aligned(8));
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::size_t>(&any_cast<over_aligned&>(x)) % 64, 0u);
+    any<intrusive_concept> y(x);
+    BOOST_CHECK_EQUAL(any_cast<over_aligned&>(y).value, 8);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::size_t>(&any_cast<over_aligned&>(y)) % 64, 0u);
+}
+
+#endif
+
+BOOST_AUTO_TEST_CASE(test_reference)
+{
+    any<intrusive_concept> x(big(9));
+    any<common<>, _self&> r(x);
+    BOOST_CHECK_EQUAL(&any_cast<big&>(r), &any_cast<big&>(x));
+    any<intrusive_concept> y(r);
+    BOOST_CHECK_EQUAL(any_cast<big&>(y).value[0], 9);
+}
+
+#endif
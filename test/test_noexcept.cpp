@@ -0,0 +1,92 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/builtin.hpp>
+#include <boost/type_erasure/any_cast.hpp>
+#include <boost/type_erasure/relaxed.hpp>
+#include <boost/type_erasure/small_buffer.hpp>
+#include <boost/type_erasure/intrusive.hpp>
+#include <boost/type_erasure/copy_on_write.hpp>
+#include <boost/mpl/vector.hpp>
+#include <vector>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::type_erasure;
+
+int copies = 0;
+
+struct counted
+{
+    counted(int v = 0) : value(v) {}
+    counted(const counted& other) : value(other.value) { ++copies; }
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    counted(counted&& other) : value(other.value) {}
+#endif
+    int value;
+};
+
+template<class T = _self>
+struct common : ::boost::mpl::vector<
+    copy_constructible<T>,
+    typeid_<T>
+> {};
+
+#if !defined(BOOST_NO_CXX11_NOEXCEPT) && !defined(BOOST_NO_CXX11_HDR_TYPE_TRAITS)
+
+BOOST_STATIC_ASSERT((std::is_nothrow_move_constructible<
+    any< ::boost::mpl::vector<common<>, relaxed> > >::value));
+BOOST_STATIC_ASSERT((std::is_nothrow_move_constructible<
+    any< ::boost::mpl::vector<common<>, relaxed, small_buffer<> > > >::value));
+BOOST_STATIC_ASSERT((!std::is_nothrow_move_constructible<
+    any<common<> > >::value));
+
+#ifdef BOOST_TYPE_ERASURE_SFINAE_FRIENDLY_CONSTRUCTORS
+BOOST_STATIC_ASSERT((std::is_nothrow_move_constructible<
+    any< ::boost::mpl::vector<common<>, relaxed, intrusive> > >::value));
+BOOST_STATIC_ASSERT((std::is_nothrow_move_constructible<
+    any< ::boost::mpl::vector<common<>, copy_on_write> > >::value));
+#endif
+
+#endif
+
+template<class Concept>
+void check_vector_growth()
+{
+    std::vector<any<Concept> > v;
+    for(int i = 0; i < 100; ++i) {
+        v.push_back(any<Concept>(counted(i)));
+    }
+    copies = 0;
+    for(int i = 0; i < 1000; ++i) {
+        v.push_back(any<Concept>(counted(i)));
+    }
+#if !defined(BOOST_NO_CXX11_NOEXCEPT) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    BOOST_CHECK_EQUAL(copies, 0);
+#endif
+    BOOST_CHECK_EQUAL(any_cast<const counted&>(v[42]).value, 42);
+}
+
+BOOST_AUTO_TEST_CASE(test_vector_growth)
+{
+    check_vector_growth< ::boost::mpl::vector<common<>, relaxed> >();
+}
+
+BOOST_AUTO_TEST_CASE(test_vector_growth_small_buffer)
+{
+    check_vector_growth< ::boost::mpl::vector<common<>, relaxed, small_buffer<> > >();
+}
+
+BOOST_AUTO_TEST_CASE(test_vector_growth_intrusive)
+{
+    check_vector_growth< ::boost::mpl::vector<common<>, relaxed, intrusive> >();
+}
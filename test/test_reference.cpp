@@ -13,7 +13,12 @@
 #include <boost/type_erasure/builtin.hpp>
 #include <boost/type_erasure/operators.hpp>
 #include <boost/type_erasure/any_cast.hpp>
+#include <boost/type_erasure/param.hpp>
 #include <boost/mpl/vector.hpp>
+#include <boost/static_assert.hpp>
+#ifndef BOOST_NO_CXX11_HDR_TYPE_TRAITS
+#include <type_traits>
+#endif
 
 #define BOOST_TEST_MAIN
 #include <boost/test/unit_test.hpp>
@@ -80,3 +85,24 @@ BOOST_AUTO_TEST_CASE(test_mixed_add)
     int k = any_cast<int>(z);
     BOOST_CHECK_EQUAL(k, 3);
 }
+
+#if !defined(BOOST_NO_CXX11_DEFAULTED_FUNCTIONS) && !defined(BOOST_NO_CXX11_HDR_TYPE_TRAITS)
+
+// A reference is just a data pointer and a table pointer,
+// which can be passed in registers.
+BOOST_AUTO_TEST_CASE(test_trivial_copy)
+{
+    typedef ::boost::mpl::vector<common<>, addable<> > test_concept;
+    BOOST_STATIC_ASSERT((std::is_trivially_copy_constructible<any<test_concept, _self&> >::value));
+    BOOST_STATIC_ASSERT((std::is_trivially_copy_constructible<any<test_concept, const _self&> >::value));
+    BOOST_STATIC_ASSERT((std::is_trivially_destructible<any<test_concept, _self&> >::value));
+    BOOST_STATIC_ASSERT((std::is_trivially_copy_constructible<param<test_concept, const _self&> >::value));
+    BOOST_STATIC_ASSERT((std::is_trivially_copy_constructible<param<test_concept, _self&> >::value));
+    BOOST_CHECK_EQUAL(sizeof(any<test_concept, _self&>), 2 * sizeof(void*));
+    int i = 1;
+    any<test_concept, _self&> x(i);
+    any<test_concept, _self&> y(x);
+    BOOST_CHECK_EQUAL(&any_cast<int&>(y), &i);
+}
+
+#endif
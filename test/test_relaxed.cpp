@@ -14,6 +14,7 @@
 #include <boost/type_erasure/operators.hpp>
 #include <boost/type_erasure/any_cast.hpp>
 #include <boost/type_erasure/relaxed.hpp>
+#include <boost/type_erasure/is_empty.hpp>
 #include <boost/mpl/vector.hpp>
 
 #define BOOST_TEST_MAIN
@@ -34,3 +35,23 @@ BOOST_AUTO_TEST_CASE(test_simple)
     any<src_concept> y(2.0);
     BOOST_CHECK_THROW(x + y, bad_function_call);
 }
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+
+BOOST_AUTO_TEST_CASE(test_move)
+{
+    typedef ::boost::mpl::vector<common<>, relaxed> test_concept;
+    any<test_concept> x(1);
+    int* p = any_cast<int*>(&x);
+    any<test_concept> y(std::move(x));
+    BOOST_CHECK(is_empty(x));
+    BOOST_CHECK_EQUAL(any_cast<int*>(&y), p);
+    BOOST_CHECK_EQUAL(any_cast<int>(y), 1);
+    x = std::move(y);
+    BOOST_CHECK(is_empty(y));
+    BOOST_CHECK_EQUAL(any_cast<int*>(&x), p);
+    y = x;
+    BOOST_CHECK_EQUAL(any_cast<int>(y), 1);
+}
+
+#endif
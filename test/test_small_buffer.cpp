@@ -0,0 +1,165 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/builtin.hpp>
+#include <boost/type_erasure/operators.hpp>
+#include <boost/type_erasure/any_cast.hpp>
+#include <boost/type_erasure/relaxed.hpp>
+#include <boost/type_erasure/small_buffer.hpp>
+#include <boost/mpl/vector.hpp>
+#include <string>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::type_erasure;
+
+template<class T = _self>
+struct common : ::boost::mpl::vector<
+    copy_constructible<T>,
+    typeid_<T>
+> {};
+
+typedef ::boost::mpl::vector<common<>, small_buffer<> > buffered_concept;
+typedef ::boost::mpl::vector<common<>, relaxed, small_buffer<> > relaxed_concept;
+
+template<class Any>
+bool is_inline(const Any& arg)
+{
+    const char* p = static_cast<const char*>(any_cast<const void*>(&arg));
+    const char* first = reinterpret_cast<const char*>(&arg);
+    return p >= first && p < first + sizeof(Any);
+}
+
+struct counted
+{
+    counted(int v = 0) : value(v) { ++count; }
+    counted(const counted& other) BOOST_NOEXCEPT : value(other.value) { ++count; }
+    ~counted() { --count; }
+    int value;
+    static int count;
+};
+
+int counted::count = 0;
+
+struct big
+{
+    big(int v = 0) { value[0] = v; }
+    int value[32];
+};
+
+struct throwing_move
+{
+    throwing_move(int v = 0) : value(v) {}
+    throwing_move(const throwing_move& other) : value(other.value) {}
+    int value;
+};
+
+BOOST_AUTO_TEST_CASE(test_basic)
+{
+    any<buffered_concept> x(1);
+    BOOST_CHECK_EQUAL(any_cast<int>(x), 1);
+    any<buffered_concept> y(std::string("abc"));
+    BOOST_CHECK_EQUAL(any_cast<std::string>(y), "abc");
+    any<buffered_concept> z(big(2));
+    BOOST_CHECK_EQUAL(any_cast<const big&>(z).value[0], 2);
+#ifdef BOOST_TYPE_ERASURE_SFINAE_FRIENDLY_CONSTRUCTORS
+    BOOST_CHECK(is_inline(x));
+    BOOST_CHECK(!is_inline(z));
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(test_not_nothrow_movable)
+{
+    any<buffered_concept> x((throwing_move(3)));
+    BOOST_CHECK_EQUAL(any_cast<throwing_move&>(x).value, 3);
+    BOOST_CHECK(!is_inline(x));
+}
+
+BOOST_AUTO_TEST_CASE(test_copy)
+{
+    {
+        any<buffered_concept> x((counted(4)));
+        any<buffered_concept> y(x);
+        BOOST_CHECK_EQUAL(any_cast<counted&>(y).value, 4);
+        BOOST_CHECK(any_cast<counted*>(&x) != any_cast<counted*>(&y));
+        BOOST_CHECK_EQUAL(counted::count, 2);
+#ifdef BOOST_TYPE_ERASURE_SFINAE_FRIENDLY_CONSTRUCTORS
+        BOOST_CHECK(is_inline(y));
+#endif
+    }
+    BOOST_CHECK_EQUAL(counted::count, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_convert)
+{
+    typedef ::boost::mpl::vector<common<> > plain_concept;
+    any<plain_concept> x(5);
+    any<buffered_concept> y(x);
+    BOOST_CHECK_EQUAL(any_cast<int>(y), 5);
+    any<plain_concept> z(y);
+    BOOST_CHECK_EQUAL(any_cast<int>(z), 5);
+    any<buffered_concept, _self&> r(y);
+    BOOST_CHECK_EQUAL(any_cast<int*>(&r), any_cast<int*>(&y));
+}
+
+BOOST_AUTO_TEST_CASE(test_assign)
+{
+    {
+        any<relaxed_concept> x((counted(6)));
+        any<relaxed_concept> y(big(7));
+        x = y;
+        BOOST_CHECK_EQUAL(any_cast<big&>(x).value[0], 7);
+        BOOST_CHECK_EQUAL(counted::count, 0);
+        y = any<relaxed_concept>(counted(8));
+        BOOST_CHECK_EQUAL(any_cast<counted&>(y).value, 8);
+        BOOST_CHECK_EQUAL(counted::count, 1);
+        x = y;
+        BOOST_CHECK_EQUAL(any_cast<counted&>(x).value, 8);
+        BOOST_CHECK_EQUAL(counted::count, 2);
+#ifdef BOOST_TYPE_ERASURE_SFINAE_FRIENDLY_CONSTRUCTORS
+        BOOST_CHECK(is_inline(x));
+#endif
+    }
+    BOOST_CHECK_EQUAL(counted::count, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_null)
+{
+    any<relaxed_concept> x;
+    any<relaxed_concept> y(9);
+    x = y;
+    BOOST_CHECK_EQUAL(any_cast<int>(x), 9);
+    y = any<relaxed_concept>();
+    BOOST_CHECK_THROW(any_cast<int>(y), bad_any_cast);
+}
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+
+BOOST_AUTO_TEST_CASE(test_move)
+{
+    {
+        any<relaxed_concept> x((counted(10)));
+        any<relaxed_concept> y(std::move(x));
+        BOOST_CHECK_EQUAL(any_cast<counted&>(y).value, 10);
+        BOOST_CHECK_EQUAL(counted::count, 1);
+        BOOST_CHECK_THROW(any_cast<counted&>(x), bad_any_cast);
+        x = std::move(y);
+        BOOST_CHECK_EQUAL(any_cast<counted&>(x).value, 10);
+        BOOST_CHECK_EQUAL(counted::count, 1);
+#ifdef BOOST_TYPE_ERASURE_SFINAE_FRIENDLY_CONSTRUCTORS
+        BOOST_CHECK(is_inline(x));
+#endif
+    }
+    BOOST_CHECK_EQUAL(counted::count, 0);
+}
+
+#endif
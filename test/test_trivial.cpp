@@ -0,0 +1,156 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/builtin.hpp>
+#include <boost/type_erasure/any_cast.hpp>
+#include <boost/type_erasure/binding_of.hpp>
+#include <boost/type_erasure/relaxed.hpp>
+#include <boost/type_erasure/small_buffer.hpp>
+#include <boost/mpl/vector.hpp>
+#include <boost/mpl/map.hpp>
+#include <boost/mpl/pair.hpp>
+#include <string>
+#include <utility>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::type_erasure;
+
+template<class T = _self>
+struct common : ::boost::mpl::vector<
+    copy_constructible<T>,
+    typeid_<T>
+> {};
+
+typedef ::boost::mpl::vector<common<>, relaxed, small_buffer<> > buffered_concept;
+typedef ::boost::mpl::vector<common<>, relaxed> heap_concept;
+
+template<class Any>
+bool is_inline(const Any& arg)
+{
+    const char* p = static_cast<const char*>(any_cast<const void*>(&arg));
+    const char* first = reinterpret_cast<const char*>(&arg);
+    return p >= first && p < first + sizeof(Any);
+}
+
+struct tick
+{
+    int price;
+    short size;
+};
+
+struct big
+{
+    int value[32];
+};
+
+BOOST_AUTO_TEST_CASE(test_traits)
+{
+    typedef ::boost::type_erasure::detail::object_traits_of<tick> tick_traits;
+    // Only objects that can live in a buffer are trivial.
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    BOOST_CHECK(tick_traits::value.trivial);
+#endif
+    BOOST_CHECK_EQUAL(tick_traits::value.size, sizeof(tick));
+    BOOST_CHECK(!::boost::type_erasure::detail::object_traits_of<std::string>::value.trivial);
+    BOOST_CHECK(!::boost::type_erasure::detail::unknown_vtable_info<
+        ::boost::type_erasure::detail::object_traits>::value.trivial);
+}
+
+#ifdef BOOST_TYPE_ERASURE_SFINAE_FRIENDLY_CONSTRUCTORS
+
+BOOST_AUTO_TEST_CASE(test_binding)
+{
+    tick t = { 1, 2 };
+    any<buffered_concept> x(t);
+    BOOST_CHECK(binding_of(x).find_traits<_self>().trivial);
+    any<buffered_concept> y(std::string("abc"));
+    BOOST_CHECK(!binding_of(y).find_traits<_self>().trivial);
+    any<buffered_concept> z;
+    BOOST_CHECK(!binding_of(z).find_traits<_self>().trivial);
+}
+
+// Converting a binding keeps the traits.
+BOOST_AUTO_TEST_CASE(test_convert)
+{
+    typedef ::boost::mpl::vector<common<_a>, common<_b> > src_concept;
+    tick t = { 3, 4 };
+    ::boost::type_erasure::binding<src_concept> b(
+        make_binding< ::boost::mpl::map<
+            ::boost::mpl::pair<_a, tick>,
+            ::boost::mpl::pair<_b, std::string> > >());
+    ::boost::type_erasure::binding<common<> > a_binding(b, make_binding< ::boost::mpl::map<
+        ::boost::mpl::pair<_self, _a> > >());
+    ::boost::type_erasure::binding<common<> > b_binding(b, make_binding< ::boost::mpl::map<
+        ::boost::mpl::pair<_self, _b> > >());
+    BOOST_CHECK(a_binding.find_traits<_self>().trivial);
+    BOOST_CHECK(!b_binding.find_traits<_self>().trivial);
+    any<common<> > x(t, make_binding< ::boost::mpl::map< ::boost::mpl::pair<_self, tick> > >());
+    any<common<> > y(x);
+    BOOST_CHECK_EQUAL(any_cast<tick&>(y).price, 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_copy)
+{
+    tick t = { 5, 6 };
+    any<buffered_concept> x(t);
+    any<buffered_concept> y(x);
+    BOOST_CHECK(is_inline(y));
+    BOOST_CHECK_EQUAL(any_cast<tick&>(y).price, 5);
+    BOOST_CHECK_EQUAL(any_cast<tick&>(y).size, 6);
+    BOOST_CHECK(&any_cast<tick&>(x) != &any_cast<tick&>(y));
+    big b = { { 7 } };
+    any<buffered_concept> z(b);
+    any<buffered_concept> w(z);
+    BOOST_CHECK(!is_inline(w));
+    BOOST_CHECK_EQUAL(any_cast<big&>(w).value[0], 7);
+    any<heap_concept> h(t);
+    any<heap_concept> h2(h);
+    BOOST_CHECK_EQUAL(any_cast<tick&>(h2).price, 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_move)
+{
+    tick t = { 8, 9 };
+    any<buffered_concept> x(t);
+    any<buffered_concept> y(std::move(x));
+    BOOST_CHECK(is_inline(y));
+    BOOST_CHECK_EQUAL(any_cast<tick&>(y).price, 8);
+    BOOST_CHECK(any_cast<tick*>(&x) == 0);
+    big b = { { 10 } };
+    any<buffered_concept> z(b);
+    big* p = &any_cast<big&>(z);
+    any<buffered_concept> w(std::move(z));
+    BOOST_CHECK_EQUAL(&any_cast<big&>(w), p);
+}
+
+// Without assignable, assignment copies and swaps.
+BOOST_AUTO_TEST_CASE(test_assign)
+{
+    tick t = { 11, 12 };
+    any<buffered_concept> x(t);
+    any<buffered_concept> y(std::string("abc"));
+    big b = { { 13 } };
+    any<buffered_concept> z(b);
+    y = x;
+    BOOST_CHECK_EQUAL(any_cast<tick&>(y).price, 11);
+    BOOST_CHECK(is_inline(y));
+    x = z;
+    BOOST_CHECK_EQUAL(any_cast<big&>(x).value[0], 13);
+    z = std::string("def");
+    BOOST_CHECK_EQUAL(any_cast<std::string&>(z), "def");
+    z = y;
+    BOOST_CHECK_EQUAL(any_cast<tick&>(z).price, 11);
+    BOOST_CHECK(is_inline(z));
+}
+
+#endif
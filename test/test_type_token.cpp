@@ -0,0 +1,122 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/builtin.hpp>
+#include <boost/type_erasure/operators.hpp>
+#include <boost/type_erasure/any_cast.hpp>
+#include <boost/type_erasure/binding_of.hpp>
+#include <boost/type_erasure/typeid_of.hpp>
+#include <boost/type_erasure/check_match.hpp>
+#include <boost/type_erasure/dynamic_any_cast.hpp>
+#include <boost/type_erasure/relaxed.hpp>
+#include <boost/mpl/vector.hpp>
+#include <boost/mpl/map.hpp>
+#include <boost/mpl/pair.hpp>
+#include <string>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::type_erasure;
+
+template<class T = _self>
+struct common : ::boost::mpl::vector<
+    copy_constructible<T>,
+    typeid_<T>
+> {};
+
+struct fixture
+{
+    fixture()
+    {
+        register_binding<common<>, int>();
+        register_binding<incrementable<>, int>();
+    }
+};
+
+BOOST_GLOBAL_FIXTURE(fixture);
+
+BOOST_AUTO_TEST_CASE(test_same_type)
+{
+    using ::boost::type_erasure::detail::type_token_of;
+    using ::boost::type_erasure::detail::same_type;
+    BOOST_CHECK(same_type(type_token_of<int>::value, type_token_of<int>::value));
+    BOOST_CHECK(!same_type(type_token_of<int>::value, type_token_of<long>::value));
+    BOOST_CHECK(!same_type(type_token_of<int>::value, type_token_of<std::string>::value));
+    BOOST_CHECK(*type_token_of<std::string>::value.type == typeid(std::string));
+    BOOST_CHECK(*type_token_of<std::string>::value.hash != 0);
+}
+
+// Only the variadic vtable stores tokens.
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_CONSTEXPR) && !defined(BOOST_NO_CXX11_DEFAULTED_FUNCTIONS)
+
+BOOST_AUTO_TEST_CASE(test_binding)
+{
+    any<common<> > x(1);
+    const ::boost::type_erasure::detail::type_token& token =
+        binding_of(x).find_type_token<_self>();
+    BOOST_CHECK(token.type != 0);
+    BOOST_CHECK(*token.type == typeid(int));
+    any< ::boost::mpl::vector<common<>, relaxed> > y;
+    BOOST_CHECK(*binding_of(y).find_type_token<_self>().type == typeid(void));
+}
+
+#endif
+
+// Converting a binding keeps the token.
+BOOST_AUTO_TEST_CASE(test_convert)
+{
+    typedef ::boost::mpl::vector<common<_a>, common<_b> > src_concept;
+    ::boost::type_erasure::binding<src_concept> b(
+        make_binding< ::boost::mpl::map<
+            ::boost::mpl::pair<_a, int>,
+            ::boost::mpl::pair<_b, std::string> > >());
+    ::boost::type_erasure::binding<common<> > b_binding(b, make_binding< ::boost::mpl::map<
+        ::boost::mpl::pair<_self, _b> > >());
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_CONSTEXPR) && !defined(BOOST_NO_CXX11_DEFAULTED_FUNCTIONS)
+    BOOST_CHECK(*b_binding.find_type_token<_self>().type == typeid(std::string));
+#endif
+    BOOST_CHECK(typeid_of<_self>(b_binding) == typeid(std::string));
+    BOOST_CHECK(typeid_of<_b>(b) == typeid(std::string));
+}
+
+BOOST_AUTO_TEST_CASE(test_any_cast)
+{
+    any<common<> > x(1);
+    BOOST_CHECK_EQUAL(any_cast<int>(x), 1);
+    BOOST_CHECK_EQUAL(any_cast<const int&>(x), 1);
+    BOOST_CHECK(any_cast<long*>(&x) == 0);
+    BOOST_CHECK_THROW(any_cast<std::string>(x), bad_any_cast);
+    BOOST_CHECK(typeid_of(x) == typeid(int));
+}
+
+// A binding that comes from a dynamic_binding does not know
+// the type, so these fall back to calling typeid_.
+BOOST_AUTO_TEST_CASE(test_dynamic)
+{
+    any<common<> > x(1);
+    typedef any< ::boost::mpl::vector<common<>, incrementable<> > > incrementable_any;
+    incrementable_any y = dynamic_any_cast<incrementable_any>(x);
+    BOOST_CHECK(binding_of(y).find_type_token<_self>().type == 0);
+    BOOST_CHECK(typeid_of(y) == typeid(int));
+    BOOST_CHECK_EQUAL(any_cast<int>(y), 1);
+    BOOST_CHECK(any_cast<long*>(&y) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_check_match)
+{
+    typedef ::boost::mpl::vector<common<>, addable<>, relaxed> test_concept;
+    any<test_concept> x(1);
+    any<test_concept> y(2);
+    any<test_concept> z(2.0);
+    BOOST_CHECK(check_match(addable<>(), x, y));
+    BOOST_CHECK(!check_match(addable<>(), x, z));
+}
@@ -0,0 +1,193 @@
+// Boost.TypeErasure library
+//
+// Copyright 2011 Steven Watanabe
+//
+// Distributed under the Boost Software License Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// $Id$
+
+#include <boost/type_erasure/any.hpp>
+#include <boost/type_erasure/builtin.hpp>
+#include <boost/type_erasure/operators.hpp>
+#include <boost/type_erasure/any_cast.hpp>
+#include <boost/type_erasure/relaxed.hpp>
+#include <boost/type_erasure/small_buffer.hpp>
+#include <boost/type_erasure/with_allocator.hpp>
+#include <boost/mpl/vector.hpp>
+#include <cstddef>
+#include <new>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::type_erasure;
+
+struct alloc_stats
+{
+    alloc_stats() : allocations(0), deallocations(0) {}
+    int allocations;
+    int deallocations;
+};
+
+alloc_stats default_stats;
+
+template<class T>
+struct counting_allocator
+{
+    typedef T value_type;
+    counting_allocator() : stats(&default_stats) {}
+    explicit counting_allocator(alloc_stats* s) : stats(s) {}
+    template<class U>
+    counting_allocator(const counting_allocator<U>& other) : stats(other.stats) {}
+    T* allocate(std::size_t n)
+    {
+        ++stats->allocations;
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T* p, std::size_t)
+    {
+        ++stats->deallocations;
+        ::operator delete(p);
+    }
+    alloc_stats* stats;
+};
+
+template<class T, class U>
+bool operator==(const counting_allocator<T>& lhs, const counting_allocator<U>& rhs)
+{ return lhs.stats == rhs.stats; }
+template<class T, class U>
+bool operator!=(const counting_allocator<T>& lhs, const counting_allocator<U>& rhs)
+{ return lhs.stats != rhs.stats; }
+
+typedef counting_allocator<char> allocator_type;
+
+template<class T = _self>
+struct common : ::boost::mpl::vector<
+    copy_constructible<T>,
+    typeid_<T>
+> {};
+
+typedef ::boost::mpl::vector<common<>, relaxed, with_allocator<allocator_type> > allocated_concept;
+typedef ::boost::mpl::vector<common<>, relaxed, with_allocator<allocator_type>, small_buffer<> > buffered_concept;
+
+struct big
+{
+    big(int v = 0) { value[0] = v; }
+    int value[32];
+};
+
+BOOST_AUTO_TEST_CASE(test_value)
+{
+    any<allocated_concept> x(big(1));
+    BOOST_CHECK_EQUAL(any_cast<big&>(x).value[0], 1);
+    any<allocated_concept> y(x);
+    BOOST_CHECK_EQUAL(any_cast<big&>(y).value[0], 1);
+    x = any<allocated_concept>(2);
+    BOOST_CHECK_EQUAL(any_cast<int>(x), 2);
+}
+
+#ifdef BOOST_TYPE_ERASURE_SFINAE_FRIENDLY_CONSTRUCTORS
+
+BOOST_AUTO_TEST_CASE(test_allocator_arg)
+{
+    alloc_stats stats;
+    {
+        any<allocated_concept> x(std::allocator_arg, allocator_type(&stats), big(3));
+        BOOST_CHECK_EQUAL(any_cast<big&>(x).value[0], 3);
+        BOOST_CHECK_EQUAL(stats.allocations, 1);
+        BOOST_CHECK_EQUAL(stats.deallocations, 0);
+    }
+    BOOST_CHECK_EQUAL(stats.allocations, 1);
+    BOOST_CHECK_EQUAL(stats.deallocations, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_default_allocator)
+{
+    int allocations = default_stats.allocations;
+    {
+        any<allocated_concept> x(big(4));
+        BOOST_CHECK_EQUAL(default_stats.allocations, allocations + 1);
+    }
+    BOOST_CHECK_EQUAL(default_stats.deallocations, default_stats.allocations);
+}
+
+BOOST_AUTO_TEST_CASE(test_copy)
+{
+    alloc_stats stats;
+    {
+        any<allocated_concept> x(std::allocator_arg, allocator_type(&stats), big(5));
+        any<allocated_concept> y(x);
+        BOOST_CHECK_EQUAL(any_cast<big&>(y).value[0], 5);
+        BOOST_CHECK_EQUAL(stats.allocations, 2);
+    }
+    BOOST_CHECK_EQUAL(stats.deallocations, 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_move)
+{
+    alloc_stats stats;
+    {
+        any<allocated_concept> x(std::allocator_arg, allocator_type(&stats), big(6));
+        any<allocated_concept> y(std::move(x));
+        BOOST_CHECK_EQUAL(any_cast<big&>(y).value[0], 6);
+        BOOST_CHECK_EQUAL(stats.allocations, 1);
+        BOOST_CHECK_EQUAL(stats.deallocations, 0);
+    }
+    BOOST_CHECK_EQUAL(stats.deallocations, 1);
+}
+
+// Assignment is implemented by copy and swap.
+BOOST_AUTO_TEST_CASE(test_assign)
+{
+    alloc_stats stats1, stats2;
+    {
+        any<allocated_concept> x(std::allocator_arg, allocator_type(&stats1), big(7));
+        any<allocated_concept> y(std::allocator_arg, allocator_type(&stats2), 8);
+        x = y;
+        BOOST_CHECK_EQUAL(any_cast<int>(x), 8);
+        BOOST_CHECK_EQUAL(stats1.deallocations, 1);
+        BOOST_CHECK_EQUAL(stats2.allocations, 2);
+        BOOST_CHECK_EQUAL(stats2.deallocations, 0);
+    }
+    BOOST_CHECK_EQUAL(stats1.deallocations, 1);
+    BOOST_CHECK_EQUAL(stats2.deallocations, 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_small_buffer)
+{
+    alloc_stats stats;
+    {
+        any<buffered_concept> x(std::allocator_arg, allocator_type(&stats), 9);
+        BOOST_CHECK_EQUAL(stats.allocations, 0);
+        any<buffered_concept> y(std::allocator_arg, allocator_type(&stats), big(10));
+        BOOST_CHECK_EQUAL(stats.allocations, 1);
+        x = y;
+        BOOST_CHECK_EQUAL(any_cast<big&>(x).value[0], 10);
+        BOOST_CHECK_EQUAL(stats.allocations, 2);
+        y = any<buffered_concept>(std::allocator_arg, allocator_type(&stats), 11);
+        BOOST_CHECK_EQUAL(any_cast<int>(y), 11);
+        BOOST_CHECK_EQUAL(stats.deallocations, 1);
+    }
+    BOOST_CHECK_EQUAL(stats.deallocations, 2);
+}
+
+// The result of a call is created with new, so the
+// allocator must not be used to free it.
+BOOST_AUTO_TEST_CASE(test_adopt)
+{
+    typedef ::boost::mpl::vector<
+        common<>, addable<>, with_allocator<allocator_type>
+    > test_concept;
+    alloc_stats stats;
+    {
+        any<test_concept> x(std::allocator_arg, allocator_type(&stats), 11);
+        any<test_concept> y(x + x);
+        BOOST_CHECK_EQUAL(any_cast<int>(y), 22);
+        BOOST_CHECK_EQUAL(stats.allocations, 1);
+    }
+    BOOST_CHECK_EQUAL(stats.deallocations, 1);
+}
+
+#endif